@@ -0,0 +1,145 @@
+#include "Benchmark.h"
+
+#include <iostream>
+
+namespace bav::benchmarks
+{
+Runner::Runner (const String& nameFilter, double minSecondsPerBenchmark)
+    : filter (nameFilter), minSeconds (minSecondsPerBenchmark)
+{
+}
+
+void Runner::addSampleBenchmark (const String& name, int samplesPerIteration, std::function< void() > body)
+{
+    run (name, "sample", samplesPerIteration, body);
+}
+
+void Runner::addByteBenchmark (const String& name, int bytesPerIteration, std::function< void() > body)
+{
+    run (name, "byte", bytesPerIteration, body);
+}
+
+void Runner::run (const String& name, const String& unit, int itemsPerIteration, std::function< void() >& body)
+{
+    jassert (itemsPerIteration > 0);
+
+    if (filter.isNotEmpty() && ! name.containsIgnoreCase (filter)) return;
+
+    // audio code runs with denormals flushed, and a benchmark whose signal decays shouldn't slow down as it goes
+    juce::ScopedNoDenormals noDenormals;
+
+    static constexpr int numBatches = 5;
+
+    auto timeBatch = [&body] (int numIterations)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        for (int i = 0; i < numIterations; ++i)
+            body();
+
+        return juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start);
+    };
+
+    // this also warms up the caches and the branch predictors
+    auto iterations = 1;
+
+    while (timeBatch (iterations) < minSeconds / numBatches && iterations < (1 << 24))
+        iterations *= 2;
+
+    std::array< double, numBatches > batchSeconds;
+
+    for (auto& seconds : batchSeconds)
+        seconds = timeBatch (iterations);
+
+    std::sort (batchSeconds.begin(), batchSeconds.end());
+
+    Result result;
+
+    result.name               = name;
+    result.unit               = unit;
+    result.itemsPerIteration  = itemsPerIteration;
+    result.iterationsPerBatch = iterations;
+    result.nsPerItem          = batchSeconds[numBatches / 2] * 1.0e9 / (static_cast< double > (iterations) * itemsPerIteration);
+
+    std::cerr << name << ": " << String (result.nsPerItem, 3) << " ns/" << unit;
+
+    if (unit == "sample")
+        std::cerr << ", " << String (1.0e9 / (result.nsPerItem * samplerate), 1) << "x realtime";
+
+    std::cerr << std::endl;
+
+    results.push_back (result);
+}
+
+String Runner::toJSON() const
+{
+    juce::Array< juce::var > benchmarks;
+
+    for (const auto& result : results)
+    {
+        auto* object = new juce::DynamicObject();
+
+        object->setProperty ("name", result.name);
+        object->setProperty ("unit", result.unit);
+        object->setProperty ("ns_per_" + result.unit, result.nsPerItem);
+
+        if (result.unit == "sample")
+            object->setProperty ("realtime_factor", 1.0e9 / (result.nsPerItem * samplerate));
+
+        object->setProperty ("items_per_iteration", result.itemsPerIteration);
+        object->setProperty ("iterations_per_batch", result.iterationsPerBatch);
+
+        benchmarks.add (juce::var (object));
+    }
+
+    auto* root = new juce::DynamicObject();
+
+    root->setProperty ("samplerate", samplerate);
+    root->setProperty ("os", juce::SystemStats::getOperatingSystemName());
+    root->setProperty ("cpu_vendor", juce::SystemStats::getCpuVendor());
+    root->setProperty ("num_cpus", juce::SystemStats::getNumCpus());
+    root->setProperty ("juce_version", juce::SystemStats::getJUCEVersion());
+    root->setProperty ("vecops", vecops::isUsingVDSP() ? "vDSP" : (vecops::isUsingFallback() ? "fallback" : "SIMD library"));
+    root->setProperty ("benchmarks", benchmarks);
+
+    return juce::JSON::toString (juce::var (root));
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+void doNotOptimise (const void* data)
+{
+#if JUCE_MSVC
+    static const void* volatile sink;
+    sink = data;
+    _ReadWriteBarrier();
+#else
+    asm volatile ("" : : "r"(data) : "memory");
+#endif
+}
+
+template < typename SampleType >
+void fillWithNoise (SampleType* data, int numSamples, SampleType min, SampleType max)
+{
+    juce::Random random (0x5eed);
+
+    for (int i = 0; i < numSamples; ++i)
+        data[i] = min + static_cast< SampleType > (random.nextDouble()) * (max - min);
+}
+
+template void fillWithNoise (float*, int, float, float);
+template void fillWithNoise (double*, int, double, double);
+
+template < typename SampleType >
+void fillWithSine (SampleType* data, int numSamples, double frequency, double sampleRate)
+{
+    const auto increment = juce::MathConstants< double >::twoPi * frequency / sampleRate;
+
+    for (int i = 0; i < numSamples; ++i)
+        data[i] = static_cast< SampleType > (std::sin (increment * i));
+}
+
+template void fillWithSine (float*, int, double, double);
+template void fillWithSine (double*, int, double, double);
+
+}  // namespace bav::benchmarks
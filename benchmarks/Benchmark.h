@@ -0,0 +1,69 @@
+#pragma once
+
+#include <bv_synth/bv_synth.h>
+#include <bv_psola/bv_psola.h>
+#include <bv_audio_effects/bv_audio_effects.h>
+#include <bv_serializing/bv_serializing.h>
+
+namespace bav::benchmarks
+{
+/*
+    Times small pieces of code and reports how long they take per item processed: per sample for DSP, with the real-time factor at the benchmark samplerate, or per byte for serialization.
+    Each benchmark is run in several batches after a warm-up, and the median batch is reported, which keeps one-off interruptions out of the results.
+*/
+class Runner
+{
+public:
+    static constexpr double samplerate = 44100.;
+
+    struct Result
+    {
+        String name;
+        String unit;  // "sample" or "byte"
+
+        int    itemsPerIteration {0};
+        int    iterationsPerBatch {0};
+        double nsPerItem {0.};
+    };
+
+    Runner (const String& nameFilter, double minSecondsPerBenchmark);
+
+    /* Times body, which processes itemsPerIteration samples each time it's called. */
+    void addSampleBenchmark (const String& name, int samplesPerIteration, std::function< void() > body);
+
+    /* Times body, which processes itemsPerIteration bytes each time it's called. */
+    void addByteBenchmark (const String& name, int bytesPerIteration, std::function< void() > body);
+
+    const std::vector< Result >& getResults() const { return results; }
+
+    String toJSON() const;
+
+private:
+    void run (const String& name, const String& unit, int itemsPerIteration, std::function< void() >& body);
+
+    const String filter;
+    const double minSeconds;
+
+    std::vector< Result > results;
+};
+
+
+/* Stops the compiler from optimising away work whose result is never otherwise read. */
+void doNotOptimise (const void* data);
+
+/* Deterministic noise, so every run of the suite processes the same signals. */
+template < typename SampleType >
+void fillWithNoise (SampleType* data, int numSamples, SampleType min = SampleType (-1), SampleType max = SampleType (1));
+
+template < typename SampleType >
+void fillWithSine (SampleType* data, int numSamples, double frequency, double samplerate = Runner::samplerate);
+
+
+void addVecopsBenchmarks (Runner& runner);
+void addFilterBenchmarks (Runner& runner);
+void addPitchBenchmarks (Runner& runner);
+void addSynthBenchmarks (Runner& runner);
+void addFxBenchmarks (Runner& runner);
+void addSerializingBenchmarks (Runner& runner);
+
+}  // namespace bav::benchmarks
@@ -0,0 +1,93 @@
+#include "Benchmark.h"
+
+namespace bav::benchmarks
+{
+static constexpr int filterBlocksize = 512;
+
+/* A low pass of the given order: the first- and second-order designs, and their product for the third order. */
+template < typename SampleType >
+static dsp::filters::Coefficients< SampleType > makeLowPassOfOrder (int order)
+{
+    dsp::filters::Coefficients< SampleType > coefs;
+
+    const auto frequency = SampleType (1000);
+
+    if (order == 1)
+    {
+        coefs.makeFirstOrderLowPass (Runner::samplerate, frequency);
+        return coefs;
+    }
+
+    coefs.makeLowPass (Runner::samplerate, frequency);
+
+    if (order == 2) return coefs;
+
+    jassert (order == 3);
+
+    dsp::filters::Coefficients< SampleType > firstOrder;
+    firstOrder.makeFirstOrderLowPass (Runner::samplerate, frequency);
+
+    const auto& c = coefs.coefficients;       // b0 b1 b2 a1 a2
+    const auto& f = firstOrder.coefficients;  // b0 b1 a1
+
+    // in the form with a0 included, since that is the only way an initialiser list can describe a third order
+    coefs.coefficients = {c[0] * f[0],
+                          c[0] * f[1] + c[1] * f[0],
+                          c[1] * f[1] + c[2] * f[0],
+                          c[2] * f[1],
+                          SampleType (1),
+                          c[3] + f[2],
+                          c[4] + c[3] * f[2],
+                          c[4] * f[2]};
+
+    return coefs;
+}
+
+template < typename SampleType >
+static void addFilterBenchmarksFor (Runner& runner, const String& typeName)
+{
+    using namespace dsp::filters;
+
+    // the highest order Coefficients can describe is maxFilterOrder
+    for (int order = 1; order <= maxFilterOrder; ++order)
+    {
+        const auto suffix = " order " + String (order) + " x" + String (filterBlocksize);
+
+        auto filter = std::make_shared< Filter< SampleType > >();
+        auto audio  = std::make_shared< juce::AudioBuffer< SampleType > > (2, filterBlocksize);
+
+        fillWithNoise (audio->getWritePointer (0), filterBlocksize);
+        fillWithNoise (audio->getWritePointer (1), filterBlocksize);
+
+        filter->coefs = makeLowPassOfOrder< SampleType > (order);
+        filter->prepare();
+
+        jassert (filter->coefs.getFilterOrder() == order);
+
+        runner.addSampleBenchmark ("filters::Filter<" + typeName + ">" + suffix, filterBlocksize, [filter, audio]
+                                   {
+                                       filter->process (audio->getWritePointer (0), filterBlocksize);
+                                       doNotOptimise (audio->getReadPointer (0));
+                                   });
+
+        auto multiFilter = std::make_shared< MultiFilter< SampleType, 2 > >();
+
+        multiFilter->coefs = filter->coefs;
+        multiFilter->prepare();
+
+        // reported per sample of each channel, so it compares directly with the mono filter
+        runner.addSampleBenchmark ("filters::MultiFilter<" + typeName + ", 2>" + suffix, filterBlocksize * 2, [multiFilter, audio]
+                                   {
+                                       multiFilter->process (*audio);
+                                       doNotOptimise (audio->getReadPointer (0));
+                                   });
+    }
+}
+
+void addFilterBenchmarks (Runner& runner)
+{
+    addFilterBenchmarksFor< float > (runner, "float");
+    addFilterBenchmarksFor< double > (runner, "double");
+}
+
+}  // namespace bav::benchmarks
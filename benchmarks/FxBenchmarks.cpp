@@ -0,0 +1,162 @@
+#include "Benchmark.h"
+
+namespace bav::benchmarks
+{
+static constexpr int fxBlocksize = 512;
+
+/*
+    Each effect processes a block of stereo noise in place. The block is restored from a copy before every iteration, so the effects always see the same signal rather than their own decaying output; the copy is a small fraction of any effect's cost.
+    Results are per stereo sample frame, so the real-time factor is that of the whole effect.
+*/
+template < typename EffectType >
+static void addFxBenchmark (Runner& runner, const String& name, std::shared_ptr< EffectType > effect, std::function< void (EffectType&, juce::AudioBuffer< float >&) > process)
+{
+    struct Buffers
+    {
+        juce::AudioBuffer< float > input {2, fxBlocksize}, audio {2, fxBlocksize};
+    };
+
+    auto buffers = std::make_shared< Buffers >();
+
+    fillWithNoise (buffers->input.getWritePointer (0), fxBlocksize);
+    fillWithNoise (buffers->input.getWritePointer (1), fxBlocksize, -0.5f, 0.5f);
+
+    runner.addSampleBenchmark ("FX::" + name + " stereo x" + String (fxBlocksize), fxBlocksize, [effect, buffers, process]
+                               {
+                                   buffers->audio.makeCopyOf (buffers->input, true);
+                                   process (*effect, buffers->audio);
+                                   doNotOptimise (buffers->audio.getReadPointer (0));
+                               });
+}
+
+template < typename EffectType >
+static void addFxBenchmark (Runner& runner, const String& name, std::shared_ptr< EffectType > effect)
+{
+    effect->prepare (Runner::samplerate, fxBlocksize);
+
+    addFxBenchmark< EffectType > (runner, name, effect, [] (EffectType& e, juce::AudioBuffer< float >& audio) { e.process (audio); });
+}
+
+void addFxBenchmarks (Runner& runner)
+{
+    using namespace dsp::FX;
+
+    {
+        auto eq = std::make_shared< EQ< float > >();
+        eq->addBand (FilterType::LowShelf, 120.f, 0.7f, 1.5f);
+        eq->addBand (FilterType::Peak, 1000.f, 1.2f, 0.7f);
+        eq->addBand (FilterType::HighShelf, 8000.f, 0.7f, 1.3f);
+        addFxBenchmark (runner, "EQ 3 bands", eq);
+    }
+
+    addFxBenchmark (runner, "Filter", std::make_shared< Filter< float > > (FilterType::LowPass, 2000.f));
+
+    {
+        auto compressor = std::make_shared< Compressor< float > >();
+        compressor->setThreshold (-18.f);
+        compressor->setRatio (4.f);
+        addFxBenchmark (runner, "Compressor", compressor);
+    }
+
+    {
+        auto limiter = std::make_shared< Limiter< float > >();
+        limiter->setThreshold (-6.f);
+        addFxBenchmark (runner, "Limiter", limiter);
+    }
+
+    {
+        auto gate = std::make_shared< NoiseGate< float > >();
+        gate->setThreshold (-12.f);
+        addFxBenchmark (runner, "NoiseGate", gate);
+    }
+
+    {
+        auto gain = std::make_shared< SmoothedGain< float, 2 > >();
+        gain->setGain (0.5f);
+        addFxBenchmark (runner, "SmoothedGain", gain);
+    }
+
+    {
+        auto deEsser = std::make_shared< DeEsser< float > >();
+        deEsser->setThresh (-18.f);
+        deEsser->setDeEssAmount (60);
+        addFxBenchmark (runner, "DeEsser", deEsser);
+    }
+
+    {
+        auto delay = std::make_shared< Delay< float > >();
+        delay->setMaxDelay (44100);
+        delay->setDelay (11025);
+        delay->setDryWet (50);
+        addFxBenchmark (runner, "Delay", delay);
+    }
+
+    for (const auto irSeconds : {0.5, 2.})
+    {
+        const auto irLength = juce::roundToInt (irSeconds * Runner::samplerate);
+
+        // exponentially decaying noise, like a real room
+        juce::AudioBuffer< float > ir (2, irLength);
+
+        for (int chan = 0; chan < 2; ++chan)
+        {
+            fillWithNoise (ir.getWritePointer (chan), irLength);
+            vecops::multiplyGeometric (ir.getWritePointer (chan), 1.f, std::pow (0.001f, 1.f / static_cast< float > (irLength)), irLength);
+        }
+
+        auto convolution = std::make_shared< Convolution< float > >();
+        convolution->loadImpulseResponse (ir);
+        addFxBenchmark (runner, "Convolution " + String (irSeconds, 1) + " s IR", convolution);
+    }
+
+    {
+        // out of place, because the panner clears its output before reading its input
+        auto panner = std::make_shared< StereoPanner< float > >();
+        auto output = std::make_shared< juce::AudioBuffer< float > > (2, fxBlocksize);
+        panner->prepare (Runner::samplerate, fxBlocksize);
+        panner->setMidiPan (32);
+
+        addFxBenchmark< StereoPanner< float > > (runner, "StereoPanner", panner, [output] (StereoPanner< float >& p, juce::AudioBuffer< float >& audio) { p.process (audio, *output); });
+    }
+
+    {
+        // the block being processed is the wet signal, mixed with a fixed dry one
+        auto mixer = std::make_shared< DryWetMixer< float > >();
+        auto dry   = std::make_shared< juce::AudioBuffer< float > > (2, fxBlocksize);
+        fillWithNoise (dry->getWritePointer (0), fxBlocksize);
+        fillWithNoise (dry->getWritePointer (1), fxBlocksize);
+        mixer->prepare (2, fxBlocksize, Runner::samplerate);
+        mixer->setWetMix (35);
+
+        addFxBenchmark< DryWetMixer< float > > (runner, "DryWetMixer", mixer, [dry] (DryWetMixer< float >& m, juce::AudioBuffer< float >& audio) { m.process (*dry, audio); });
+    }
+
+    {
+        // stereo to mono and back again
+        auto converter = std::make_shared< MonoStereoConverter< float > >();
+        auto mono      = std::make_shared< juce::AudioBuffer< float > > (1, fxBlocksize);
+        converter->prepare (fxBlocksize);
+        converter->setStereoReductionMode (MonoStereoConverter< float >::mixToMono);
+
+        addFxBenchmark< MonoStereoConverter< float > > (runner, "MonoStereoConverter", converter, [mono] (MonoStereoConverter< float >& c, juce::AudioBuffer< float >& audio)
+                                                        {
+                                                            c.convertStereoToMono (audio, *mono);
+                                                            c.convertMonoToStereo (*mono, audio);
+                                                        });
+    }
+
+    auto addReverbBenchmark = [&runner] (const String& name, auto reverb)
+    {
+        using ReverbType = typename decltype (reverb)::element_type;
+
+        reverb->prepare (fxBlocksize, Runner::samplerate, 2);
+        reverb->setDryWet (35);
+
+        addFxBenchmark< ReverbType > (runner, name, reverb, [] (ReverbType& r, juce::AudioBuffer< float >& audio) { r.process (audio); });
+    };
+
+    addReverbBenchmark ("Reverb", std::make_shared< Reverb< float > >());
+    addReverbBenchmark ("FDNReverb", std::make_shared< FDNReverb< float > >());
+}
+
+}  // namespace bav::benchmarks
@@ -0,0 +1,75 @@
+#include "Benchmark.h"
+
+#include <iostream>
+
+/*
+    Runs the benchmark suite. Progress is printed to stderr as each benchmark finishes, and the results are written as JSON to the --output file, or to stdout.
+*/
+int main (int argc, char* argv[])
+{
+    using namespace bav;
+
+    String nameFilter;
+    File   outputFile;
+    double minSeconds = 0.5;
+
+    auto printUsage = []
+    {
+        std::cout << "Usage: bv_benchmarks [options]\n"
+                     "  --filter <text>       only run the benchmarks whose names contain this text\n"
+                     "  --output <file>       where the JSON results are written (default: stdout)\n"
+                     "  --min-time <seconds>  the least time spent timing each benchmark (default: 0.5)\n";
+    };
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const String arg {argv[i]};
+
+        if (i + 1 >= argc)
+        {
+            std::cout << "Missing a value for " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+
+        const String value {argv[++i]};
+
+        if (arg == "--filter")
+            nameFilter = value;
+        else if (arg == "--output")
+            outputFile = File::getCurrentWorkingDirectory().getChildFile (value);
+        else if (arg == "--min-time")
+            minSeconds = std::max (0.01, value.getDoubleValue());
+        else
+        {
+            std::cout << "Unknown option " << arg << " " << value << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+
+    benchmarks::Runner runner {nameFilter, minSeconds};
+
+    benchmarks::addVecopsBenchmarks (runner);
+    benchmarks::addFilterBenchmarks (runner);
+    benchmarks::addPitchBenchmarks (runner);
+    benchmarks::addSynthBenchmarks (runner);
+    benchmarks::addFxBenchmarks (runner);
+    benchmarks::addSerializingBenchmarks (runner);
+
+    const auto json = runner.toJSON();
+
+    if (outputFile == File())
+    {
+        std::cout << json << std::endl;
+        return 0;
+    }
+
+    if (! outputFile.replaceWithText (json))
+    {
+        std::cerr << "Couldn't write " << outputFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
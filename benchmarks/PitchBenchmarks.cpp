@@ -0,0 +1,80 @@
+#include "Benchmark.h"
+
+namespace bav::benchmarks
+{
+static constexpr double inputFrequency = 220.;
+
+static void addPitchDetectorBenchmarks (Runner& runner)
+{
+    struct HzRange
+    {
+        int min, max;
+    };
+
+    for (const auto range : {HzRange {80, 400}, HzRange {60, 1000}, HzRange {50, 2000}})
+    {
+        for (const auto frameSize : {1024, 2048, 4096})
+        {
+            // a frame has to hold two periods of the lowest frequency
+            if (frameSize < 2 * juce::roundToInt (Runner::samplerate / range.min)) continue;
+
+            auto detector = std::make_shared< dsp::PitchDetector< float > >();
+            auto frame    = std::make_shared< std::vector< float > > (static_cast< size_t > (frameSize));
+
+            fillWithSine (frame->data(), frameSize, inputFrequency);
+
+            detector->initialize (frameSize);
+            detector->setSamplerate (Runner::samplerate);
+            detector->setHzRange (range.min, range.max);
+
+            runner.addSampleBenchmark ("PitchDetector::detectPitch " + String (range.min) + "-" + String (range.max) + " Hz x" + String (frameSize),
+                                       frameSize, [detector, frame, frameSize]
+                                       {
+                                           auto pitch = detector->detectPitch (frame->data(), frameSize);
+                                           doNotOptimise (&pitch);
+                                       });
+        }
+    }
+}
+
+static void addShifterBenchmarks (Runner& runner)
+{
+    static constexpr int blocksize = 2048;
+
+    for (const auto ratio : {0.5, 0.8, 1.25, 2.})
+    {
+        struct State
+        {
+            dsp::psola::Analyzer< float > analyzer;
+            dsp::psola::Shifter< float >  shifter {analyzer};
+
+            std::vector< float > input, output;
+        };
+
+        auto state = std::make_shared< State >();
+
+        state->input.resize (blocksize);
+        state->output.resize (blocksize);
+
+        fillWithSine (state->input.data(), blocksize, inputFrequency);
+
+        state->analyzer.prepare (Runner::samplerate, blocksize);
+        state->shifter.setPitch (static_cast< float > (inputFrequency * ratio), Runner::samplerate);
+
+        // the shifter resynthesises from the analyzer's grains, so each iteration includes the analysis of its frame
+        runner.addSampleBenchmark ("psola::Shifter ratio " + String (ratio, 2) + " x" + String (blocksize), blocksize, [state]
+                                   {
+                                       state->analyzer.analyzeInput (state->input.data(), blocksize);
+                                       state->shifter.getSamples (state->output.data(), blocksize);
+                                       doNotOptimise (state->output.data());
+                                   });
+    }
+}
+
+void addPitchBenchmarks (Runner& runner)
+{
+    addPitchDetectorBenchmarks (runner);
+    addShifterBenchmarks (runner);
+}
+
+}  // namespace bav::benchmarks
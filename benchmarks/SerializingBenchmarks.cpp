@@ -0,0 +1,71 @@
+#include "Benchmark.h"
+
+namespace bav::benchmarks
+{
+/* A stand-in for a large plugin state: some scalar settings plus sample and integer tables. */
+struct LargeState : SerializableData
+{
+    LargeState (int tableSize)
+        : SerializableData ("LargeState")
+    {
+        samples.resize (static_cast< size_t > (tableSize));
+        fillWithNoise (samples.data(), tableSize);
+
+        for (int i = 0; i < tableSize; ++i)
+            notes.push_back ((i * 37) % 128);
+    }
+
+    String               name {"Benchmark state"};
+    float                gain {0.5f};
+    int                  numVoices {32};
+    bool                 enabled {true};
+    std::vector< float > samples;
+    std::vector< int >   notes;
+
+private:
+    void serialize (TreeReflector& ref) final
+    {
+        ref.add ("Name", name);
+        ref.add ("Gain", gain);
+        ref.add ("NumVoices", numVoices);
+        ref.add ("Enabled", enabled);
+        ref.add ("Sample", samples);
+        ref.add ("Note", notes);
+    }
+};
+
+void addSerializingBenchmarks (Runner& runner)
+{
+    // each container element becomes its own property, so the tables are kept to sizes that are large for a plugin state
+    for (const auto tableSize : {256, 4096})
+    {
+        struct State
+        {
+            State (int size) : source (size), dest (size) { }
+
+            LargeState        source, dest;
+            juce::MemoryBlock block, scratch;
+        };
+
+        auto state = std::make_shared< State > (tableSize);
+
+        serializing::toBinary (state->source, state->block);
+
+        const auto numBytes = static_cast< int > (state->block.getSize());
+        const auto suffix   = " " + String (tableSize) + " element tables";
+
+        runner.addByteBenchmark ("serializing::toBinary" + suffix, numBytes, [state]
+                                 {
+                                     serializing::toBinary (state->source, state->scratch);
+                                     doNotOptimise (state->scratch.getData());
+                                 });
+
+        runner.addByteBenchmark ("serializing::fromBinary" + suffix, numBytes, [state]
+                                 {
+                                     serializing::fromBinary (state->block, state->dest);
+                                     doNotOptimise (state->dest.samples.data());
+                                 });
+    }
+}
+
+}  // namespace bav::benchmarks
@@ -0,0 +1,65 @@
+#include "Benchmark.h"
+
+namespace bav::benchmarks
+{
+static constexpr int synthBlocksize = 512;
+
+/* Sparse MIDI holds a chord that fills the synth's voices; dense MIDI also starts and stops notes and moves the pitch wheel all through every block. */
+static void addSynthBenchmark (Runner& runner, int numVoices, bool denseMidi)
+{
+    struct State
+    {
+        dsp::SineSynth< float >    synth;
+        juce::AudioBuffer< float > output {2, synthBlocksize};
+        MidiBuffer                 blockMidi, midi;
+    };
+
+    auto state = std::make_shared< State >();
+
+    state->synth.initialize (numVoices, Runner::samplerate, synthBlocksize);
+
+    // a held chord of as many notes as there are voices, up to every MIDI note
+    MidiBuffer chord;
+
+    for (int i = 0; i < std::min (numVoices, 128); ++i)
+        chord.addEvent (MidiMessage::noteOn (1, i, juce::uint8 (100)), 0);
+
+    state->synth.renderVoices (chord, state->output);
+
+    if (denseMidi)
+    {
+        static constexpr int numEvents = 32;
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            const auto position = i * synthBlocksize / numEvents;
+            const auto note     = (i * 37) % std::min (numVoices, 128);
+
+            state->blockMidi.addEvent (MidiMessage::noteOff (1, note), position);
+            state->blockMidi.addEvent (MidiMessage::noteOn (1, note, juce::uint8 (90)), position);
+            state->blockMidi.addEvent (MidiMessage::pitchWheel (1, 8192 + 64 * (i - numEvents / 2)), position);
+        }
+    }
+
+    runner.addSampleBenchmark ("SynthBase::renderVoices " + String (numVoices) + " voices, " + (denseMidi ? "dense" : "sparse") + " MIDI x" + String (synthBlocksize),
+                               synthBlocksize, [state]
+                               {
+                                   // the synth swaps its output MIDI into the buffer it's given
+                                   state->midi.clear();
+                                   state->midi.addEvents (state->blockMidi, 0, synthBlocksize, 0);
+
+                                   state->synth.renderVoices (state->midi, state->output);
+                                   doNotOptimise (state->output.getReadPointer (0));
+                               });
+}
+
+void addSynthBenchmarks (Runner& runner)
+{
+    for (const auto numVoices : {8, 64, 256})
+    {
+        addSynthBenchmark (runner, numVoices, false);
+        addSynthBenchmark (runner, numVoices, true);
+    }
+}
+
+}  // namespace bav::benchmarks
@@ -0,0 +1,139 @@
+#include "Benchmark.h"
+
+namespace bav::benchmarks
+{
+template < typename SampleType >
+static void addVecopsBenchmarksFor (Runner& runner, const String& typeName)
+{
+    // convert() goes between float and double
+    using OtherType = std::conditional_t< std::is_same_v< SampleType, float >, double, float >;
+
+    for (const auto size : {64, 512, 4096})
+    {
+        struct Buffers
+        {
+            std::vector< SampleType > source, a, b, signs;
+            std::vector< OtherType >  converted;
+        };
+
+        auto buffers = std::make_shared< Buffers >();
+
+        buffers->source.resize (static_cast< size_t > (size));
+        buffers->a.resize (static_cast< size_t > (size));
+        buffers->b.resize (static_cast< size_t > (size));
+        buffers->signs.resize (static_cast< size_t > (size));
+        buffers->converted.resize (static_cast< size_t > (size));
+
+        fillWithNoise (buffers->source.data(), size, SampleType (0.5), SampleType (1.5));
+        fillWithNoise (buffers->b.data(), size);
+
+        // never zero, so dividing by these is always defined
+        for (int i = 0; i < size; ++i)
+            buffers->signs[static_cast< size_t > (i)] = i % 2 == 0 ? SampleType (1) : SampleType (-1);
+
+        const auto* source = buffers->source.data();
+
+        auto* a     = buffers->a.data();
+        auto* b     = buffers->b.data();
+        auto* signs = buffers->signs.data();
+
+        auto add = [&runner, &typeName, size, buffers] (const String& primitive, std::function< void() > body)
+        {
+            runner.addSampleBenchmark ("vecops::" + primitive + "<" + typeName + "> x" + String (size), size,
+                                       [buffers, body]
+                                       {
+                                           body();
+                                           doNotOptimise (buffers->a.data());
+                                       });
+        };
+
+        // The in-place primitives would otherwise keep running on their own output, which drifts from one run to the next (fastLog2 ends up at -inf, addC grows without bound).
+        // So a is restored from the same noise before every call, and these times include that copy, which "copy" times on its own.
+        auto addInPlace = [&add, source, a, size] (const String& primitive, std::function< void() > body)
+        {
+            add (primitive, [source, a, size, body]
+                 {
+                     vecops::copy (source, a, size);
+                     body();
+                 });
+        };
+
+        add ("fill", [=] { vecops::fill (a, SampleType (0.5), size); });
+        add ("copy", [=] { vecops::copy (source, a, size); });
+        add ("convert", [=, c = buffers->converted.data()] { vecops::convert (c, source, size); });
+        add ("fillGeometric", [=] { vecops::fillGeometric (a, SampleType (1), SampleType (0.999), size); });
+
+        addInPlace ("addC", [=] { vecops::addC (a, SampleType (0.5), size); });
+        addInPlace ("addV", [=] { vecops::addV (a, b, size); });
+        addInPlace ("subtractC", [=] { vecops::subtractC (a, SampleType (0.5), size); });
+        addInPlace ("subtractV", [=] { vecops::subtractV (a, b, size); });
+        addInPlace ("multiplyC", [=] { vecops::multiplyC (a, SampleType (-1), size); });
+        addInPlace ("multiplyV", [=] { vecops::multiplyV (a, b, size); });
+        addInPlace ("divideC", [=] { vecops::divideC (a, SampleType (-1), size); });
+        addInPlace ("divideV", [=] { vecops::divideV (a, signs, size); });
+        addInPlace ("absVal", [=] { vecops::absVal (a, size); });
+        addInPlace ("squareRoot", [=] { vecops::squareRoot (a, size); });
+        addInPlace ("square", [=] { vecops::square (a, size); });
+        addInPlace ("fastLog2", [=] { vecops::fastLog2 (a, size); });
+        addInPlace ("fastExp2", [=] { vecops::fastExp2 (a, size); });
+        addInPlace ("multiplyGeometric", [=] { vecops::multiplyGeometric (a, SampleType (1), SampleType (1.0001), size); });
+        addInPlace ("normalize", [=] { vecops::normalize (a, size); });
+
+        // the searches run on b, which nothing writes to, so they always see the same noise
+        add ("findIndexOfMinElement", [=] { doNotOptimise (b + vecops::findIndexOfMinElement (b, size)); });
+        add ("findIndexOfMaxElement", [=] { doNotOptimise (b + vecops::findIndexOfMaxElement (b, size)); });
+
+        add ("findMinAndMinIndex", [=]
+             {
+                 SampleType min;
+                 int        index;
+                 vecops::findMinAndMinIndex (b, size, min, index);
+                 doNotOptimise (&min);
+             });
+
+        add ("findMaxAndMaxIndex", [=]
+             {
+                 SampleType max;
+                 int        index;
+                 vecops::findMaxAndMaxIndex (b, size, max, index);
+                 doNotOptimise (&max);
+             });
+
+        add ("locateGreatestAbsMagnitude", [=]
+             {
+                 SampleType magnitude;
+                 int        index;
+                 vecops::locateGreatestAbsMagnitude (b, size, magnitude, index);
+                 doNotOptimise (&magnitude);
+             });
+
+        add ("locateLeastAbsMagnitude", [=]
+             {
+                 SampleType magnitude;
+                 int        index;
+                 vecops::locateLeastAbsMagnitude (b, size, magnitude, index);
+                 doNotOptimise (&magnitude);
+             });
+
+        add ("findExtrema", [=]
+             {
+                 SampleType min, max;
+                 vecops::findExtrema (b, size, min, max);
+                 doNotOptimise (&max);
+             });
+
+        add ("findRangeOfExtrema", [=]
+             {
+                 auto range = vecops::findRangeOfExtrema (b, size);
+                 doNotOptimise (&range);
+             });
+    }
+}
+
+void addVecopsBenchmarks (Runner& runner)
+{
+    addVecopsBenchmarksFor< float > (runner, "float");
+    addVecopsBenchmarksFor< double > (runner, "double");
+}
+
+}  // namespace bav::benchmarks
@@ -60,7 +60,7 @@ endfunction()
 
 function (_bv_configure_juce_target)
 
-    set (options BROWSER MTS-ESP ALWAYS_VDSP NEVER_VDSP)
+    set (options BROWSER MTS-ESP ALWAYS_VDSP NEVER_VDSP DETECT_REALTIME_VIOLATIONS)
     set (oneValueArgs TARGET)
     set (multiValueArgs "")
 
@@ -106,6 +106,11 @@ function (_bv_configure_juce_target)
         _bv_configure_mts_esp (${BV_TARGETCONFIG_TARGET})
     endif()
 
+    # for debug and soak-test builds: reports allocations and locks on the audio thread
+    if (${BV_TARGETCONFIG_DETECT_REALTIME_VIOLATIONS})
+        target_compile_definitions (${BV_TARGETCONFIG_TARGET} PUBLIC BV_DETECT_REALTIME_VIOLATIONS=1)
+    endif()
+
     set (bv_targetname ${BV_TARGETCONFIG_TARGET} PARENT_SCOPE)
 endfunction()
 
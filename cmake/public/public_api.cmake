@@ -47,6 +47,17 @@ function (bv_configure_juce_app)
 endfunction()
 
 
+# Configures a console app target (created with juce_add_console_app) whose main() calls bav::dsp::runOfflineRenderer()
+function (bv_configure_offline_renderer)
+    _bv_configure_juce_target (${ARGN})
+
+    target_link_libraries (${bv_targetname} PUBLIC ${BV_PLUGIN_ONLY_MODULES})
+
+    target_compile_definitions (${bv_targetname} PUBLIC
+            JUCE_USE_CUSTOM_PLUGIN_STANDALONE_APP=0)
+endfunction()
+
+
 function (bv_add_juce_modules dir)
     _bv_add_juce_modules_internal (${dir} dummylist)
 endfunction()
@@ -13,6 +13,12 @@ void Manager< SampleType >::prepare (double samplerate, int blocksize)
         effect->prepare (samplerate, blocksize);
 
     storage.setSize (2, blocksize, true, true, true);
+
+    scratchBuffers.resize (static_cast< size_t > (numScratchBuffers));
+    scratchAliases.resize (scratchBuffers.size());
+
+    for (auto& buffer : scratchBuffers)
+        buffer.setSize (numScratchChannels, blocksize, true, true, true);
 }
 
 template < typename SampleType >
@@ -20,21 +26,65 @@ void Manager< SampleType >::process (const AudioBuffer& input)
 {
     buffers::copy (input, storage);
 
-    lastBlocksize = input.getNumSamples();
+    lastBlocksize    = input.getNumSamples();
+    processedInPlace = false;
 
     storageAlias.setDataToReferTo (storage.getArrayOfWritePointers(), storage.getNumChannels(), 0, lastBlocksize);
 
+    processEffects (storageAlias);
+}
+
+template < typename SampleType >
+void Manager< SampleType >::processInPlace (AudioBuffer& audio)
+{
+    lastBlocksize    = audio.getNumSamples();
+    processedInPlace = true;
+
+    storageAlias.setDataToReferTo (audio.getArrayOfWritePointers(), audio.getNumChannels(), 0, lastBlocksize);
+
+    processEffects (storageAlias);
+}
+
+template < typename SampleType >
+void Manager< SampleType >::processEffects (AudioBuffer& audio)
+{
     for (auto* effect : effects)
-        effect->process (storageAlias);
+        effect->process (audio);
 }
 
 template < typename SampleType >
 const juce::AudioBuffer< SampleType >& Manager< SampleType >::getProcessedSignal()
 {
-    storageAlias.setDataToReferTo (storage.getArrayOfWritePointers(), storage.getNumChannels(), 0, lastBlocksize);
+    // after processInPlace(), the alias already refers to the caller's audio
+    if (! processedInPlace)
+        storageAlias.setDataToReferTo (storage.getArrayOfWritePointers(), storage.getNumChannels(), 0, lastBlocksize);
+
     return storageAlias;
 }
 
+template < typename SampleType >
+void Manager< SampleType >::setNumScratchBuffers (int numBuffers, int numChannels)
+{
+    jassert (numBuffers >= 0 && numChannels > 0);
+
+    numScratchBuffers  = numBuffers;
+    numScratchChannels = numChannels;
+}
+
+template < typename SampleType >
+juce::AudioBuffer< SampleType >& Manager< SampleType >::getScratchBuffer (int index)
+{
+    jassert (index >= 0 && index < static_cast< int > (scratchBuffers.size()));
+
+    auto& buffer = scratchBuffers[static_cast< size_t > (index)];
+    auto& alias  = scratchAliases[static_cast< size_t > (index)];
+
+    jassert (lastBlocksize <= buffer.getNumSamples());
+
+    alias.setDataToReferTo (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), 0, lastBlocksize);
+    return alias;
+}
+
 template class Manager< float >;
 template class Manager< double >;
 
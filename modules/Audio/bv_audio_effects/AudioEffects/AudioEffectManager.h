@@ -12,10 +12,23 @@ public:
 
     void prepare (double samplerate, int blocksize);
 
+    /* Copies the input into the manager's own storage, then processes that. */
     void process (const AudioBuffer& input);
 
+    /* Processes the caller's audio directly, saving the copy. getProcessedSignal() then refers to this audio, so it must outlive any use of the processed signal. */
+    void processInPlace (AudioBuffer& audio);
+
     const AudioBuffer& getProcessedSignal();
 
+    /* Sets how many scratch buffers prepare() allocates for the effects to use. Call this before prepare(). */
+    void setNumScratchBuffers (int numBuffers, int numChannels = 2);
+
+    /*
+        Returns one of the preallocated scratch buffers, sized to the block being processed. Its contents are whatever was last left in it.
+        Effects that hold a reference to their manager can use these from their process() calls. Only call this on the audio thread, while process() or processInPlace() is running: the buffers aren't locked, and each index is shared by every effect, so an effect must be done with a buffer before it returns.
+    */
+    AudioBuffer& getScratchBuffer (int index);
+
 protected:
     void add (AudioEffect< SampleType >& effect);
 
@@ -27,12 +40,18 @@ protected:
     }
 
 private:
+    void processEffects (AudioBuffer& audio);
+
     AudioBuffer storage;
     AudioBuffer storageAlias;
 
+    std::vector< AudioBuffer > scratchBuffers, scratchAliases;
+
     juce::Array< AudioEffect< SampleType >* > effects;
 
-    int lastBlocksize {0};
+    int  lastBlocksize {0};
+    int  numScratchBuffers {0}, numScratchChannels {2};
+    bool processedInPlace {false};
 };
 
 }  // namespace bav::dsp::FX
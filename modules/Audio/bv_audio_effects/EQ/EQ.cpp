@@ -6,8 +6,90 @@ void EQ< SampleType >::process (juce::AudioBuffer< SampleType >& audio)
 {
     jassert (getNumBands() > 0);
 
-    for (auto* filter : filters)
-        filter->process (audio);
+    compileCascade();
+
+    if (cascade.empty()) return;
+
+    const auto numChannels = std::min (audio.getNumChannels(), maxChannels);
+
+    for (int chan = 0; chan < numChannels; ++chan)
+        processChannel (chan, audio.getWritePointer (chan), audio.getNumSamples());
+}
+
+template < typename SampleType >
+void EQ< SampleType >::compileCascade()
+{
+    // the storage for every band was reserved in addBand(), so this never allocates
+    cascade.clear();
+
+    for (int i = 0; i < filters.size(); ++i)
+    {
+        auto* band = filters.getUnchecked (i);
+
+        const auto active = ! band->isBypassed() && ! band->isUnity();
+
+        if (active && ! bandWasActive[static_cast< size_t > (i)])
+        {
+            const auto first = bandStates.begin() + i * maxChannels * 2;
+            std::fill (first, first + maxChannels * 2, SampleType (0));
+        }
+
+        bandWasActive[static_cast< size_t > (i)] = active;
+
+        if (! active) continue;
+
+        const auto* c = band->getCoefficients().getRawCoefficients();
+
+        cascade.push_back ({c[0], c[1], c[2], c[3], c[4], i});
+    }
+}
+
+template < typename SampleType >
+void EQ< SampleType >::processChannel (int channel, SampleType* audio, int numSamples) noexcept
+{
+    const auto numSections = cascade.size();
+
+    const auto stateIndex = [channel] (const Section& section)
+    { return static_cast< size_t > ((section.band * maxChannels + channel) * 2); };
+
+    for (size_t s = 0; s < numSections; ++s)
+    {
+        const auto index = stateIndex (cascade[s]);
+        z1[s]            = bandStates[index];
+        z2[s]            = bandStates[index + 1];
+    }
+
+    const auto* sections = cascade.data();
+    auto*       lv1      = z1.data();
+    auto*       lv2      = z2.data();
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto sample = audio[i];
+
+        for (size_t s = 0; s < numSections; ++s)
+        {
+            const auto& section = sections[s];
+
+            const auto output = (sample * section.b0) + lv1[s];
+            lv1[s]            = (sample * section.b1) - (output * section.a1) + lv2[s];
+            lv2[s]            = (sample * section.b2) - (output * section.a2);
+
+            sample = output;
+        }
+
+        audio[i] = sample;
+    }
+
+    for (size_t s = 0; s < numSections; ++s)
+    {
+        juce::dsp::util::snapToZero (z1[s]);
+        juce::dsp::util::snapToZero (z2[s]);
+
+        const auto index      = stateIndex (cascade[s]);
+        bandStates[index]     = z1[s];
+        bandStates[index + 1] = z2[s];
+    }
 }
 
 template < typename SampleType >
@@ -16,6 +98,8 @@ void EQ< SampleType >::prepare (double samplerate, int blocksize)
     for (auto* filter : filters)
         filter->prepare (samplerate, blocksize);
 
+    std::fill (bandStates.begin(), bandStates.end(), SampleType (0));
+
     lastSamplerate = samplerate;
     lastBlocksize  = blocksize;
 }
@@ -25,6 +109,14 @@ void EQ< SampleType >::addBand (Band* newFilter)
 {
     filters.add (newFilter);
     newFilter->prepare (lastSamplerate, lastBlocksize);
+
+    const auto numBands = static_cast< size_t > (filters.size());
+
+    cascade.reserve (numBands);
+    bandStates.resize (numBands * maxChannels * 2, SampleType (0));
+    bandWasActive.resize (numBands, false);
+    z1.resize (numBands);
+    z2.resize (numBands);
 }
 
 template < typename SampleType >
@@ -3,6 +3,10 @@
 
 namespace bav::dsp::FX
 {
+/*
+    A multiband EQ.
+    The active bands are compiled into one cascade of second-order sections, which runs over each channel in a single pass. Bypassed bands, and bands whose response is flat, are left out of the cascade.
+*/
 template < typename SampleType >
 class EQ : public AudioEffect< SampleType >
 {
@@ -27,8 +31,28 @@ public:
     Band* getBandOfType (FilterType type);  // returns the first filter found with the given type, else nullptr
 
 private:
+    static constexpr int maxChannels = 2;
+
+    struct Section
+    {
+        SampleType b0, b1, b2, a1, a2;
+        int        band;
+    };
+
+    void compileCascade();
+    void processChannel (int channel, SampleType* audio, int numSamples) noexcept;
+
     juce::OwnedArray< Band > filters;
 
+    std::vector< Section > cascade;
+
+    // two state variables per band and channel, kept even while a band is left out of the cascade
+    std::vector< SampleType > bandStates;
+    std::vector< bool >       bandWasActive;
+
+    // working copies of the cascade's state while a channel is processed
+    std::vector< SampleType > z1, z2;
+
     double lastSamplerate {44100.};
     int    lastBlocksize {512};
 };
@@ -15,64 +15,122 @@ Filter< SampleType >::Filter (FilterType filterType, float frequency, float Qfac
 template < typename SampleType >
 void Filter< SampleType >::process (juce::AudioBuffer< SampleType >& audio)
 {
-    switch (type)
+    if (bypassed) return;
+
+    updateCoefficients();
+
+    filter.process (audio);
+}
+
+template < typename SampleType >
+const filters::Coefficients< SampleType >& Filter< SampleType >::getCoefficients()
+{
+    updateCoefficients();
+    return filter.coefs;
+}
+
+template < typename SampleType >
+bool Filter< SampleType >::isUnity()
+{
+    updateCoefficients();
+
+    const auto& c = filter.coefs.coefficients;
+
+    if (c.size() != 5) return false;
+
+    constexpr auto tolerance = static_cast< SampleType > (1.0e-6);
+
+    const auto matches = [tolerance] (SampleType x, SampleType y)
+    { return std::abs (x - y) < tolerance; };
+
+    // b0 == 1 and b1, b2 == a1, a2
+    return matches (c[0], SampleType (1)) && matches (c[1], c[3]) && matches (c[2], c[4]);
+}
+
+template < typename SampleType >
+void Filter< SampleType >::updateCoefficients()
+{
+    // cleared before the parameters are read, so a change made while the coefficients are being calculated triggers another update
+    if (! coefsNeedUpdate.exchange (false)) return;
+
+    const auto frequency = freq.load();
+    const auto qFactor   = Q.load();
+    const auto gainMult  = gain.load();
+
+    switch (type.load())
     {
         case (LowPass) :
         {
-            filter.coefs.makeLowPass (sampleRate, freq, Q);
+            filter.coefs.makeLowPass (sampleRate, frequency, qFactor);
             break;
         }
         case (HighPass) :
         {
-            filter.coefs.makeHighPass (sampleRate, freq, Q);
+            filter.coefs.makeHighPass (sampleRate, frequency, qFactor);
             break;
         }
         case (LowShelf) :
         {
-            filter.coefs.makeLowShelf (sampleRate, freq, Q, gain);
+            filter.coefs.makeLowShelf (sampleRate, frequency, qFactor, gainMult);
             break;
         }
         case (HighShelf) :
         {
-            filter.coefs.makeHighShelf (sampleRate, freq, Q, gain);
+            filter.coefs.makeHighShelf (sampleRate, frequency, qFactor, gainMult);
             break;
         }
         case (BandPass) :
         {
-            filter.coefs.makeBandPass (sampleRate, freq, Q);
+            filter.coefs.makeBandPass (sampleRate, frequency, qFactor);
             break;
         }
         case (Notch) :
         {
-            filter.coefs.makeNotch (sampleRate, freq, Q);
+            filter.coefs.makeNotch (sampleRate, frequency, qFactor);
             break;
         }
         case (Peak) :
         {
-            filter.coefs.makePeakFilter (sampleRate, freq, Q, gain);
+            filter.coefs.makePeakFilter (sampleRate, frequency, qFactor, gainMult);
             break;
         }
         case (AllPass) :
         {
-            filter.coefs.makeAllPass (sampleRate, freq, Q);
+            filter.coefs.makeAllPass (sampleRate, frequency, qFactor);
             break;
         }
     }
-
-    filter.process (audio);
 }
 
 template < typename SampleType >
 void Filter< SampleType >::prepare (double samplerate, int)
 {
-    sampleRate = samplerate;
+    sampleRate      = samplerate;
+    coefsNeedUpdate = true;
+    updateCoefficients();
     filter.prepare();
 }
 
+template < typename SampleType >
+void Filter< SampleType >::setBypassed (bool shouldBeBypassed)
+{
+    if (bypassed && ! shouldBeBypassed)
+        filter.reset();
+
+    bypassed = shouldBeBypassed;
+}
+
+template < typename SampleType >
+bool Filter< SampleType >::isBypassed() const
+{
+    return bypassed;
+}
+
 template < typename SampleType >
 void Filter< SampleType >::setFilterType (FilterType newType)
 {
-    type = newType;
+    type            = newType;
+    coefsNeedUpdate = true;
 }
 
 template < typename SampleType >
@@ -84,38 +142,41 @@ FilterType Filter< SampleType >::getFilterType() const
 template < typename SampleType >
 void Filter< SampleType >::setFilterFrequency (float newFreqHz)
 {
-    freq = static_cast< SampleType > (newFreqHz);
+    freq            = static_cast< SampleType > (newFreqHz);
+    coefsNeedUpdate = true;
 }
 
 template < typename SampleType >
 float Filter< SampleType >::getFilterFrequency() const
 {
-    return static_cast< float > (freq);
+    return static_cast< float > (freq.load());
 }
 
 template < typename SampleType >
 void Filter< SampleType >::setQfactor (float newQ)
 {
     jassert (newQ > 0.f);
-    Q = static_cast< SampleType > (newQ);
+    Q               = static_cast< SampleType > (newQ);
+    coefsNeedUpdate = true;
 }
 
 template < typename SampleType >
 float Filter< SampleType >::getQfactor() const
 {
-    return static_cast< float > (Q);
+    return static_cast< float > (Q.load());
 }
 
 template < typename SampleType >
 void Filter< SampleType >::setGain (float newGain)
 {
-    gain = static_cast< SampleType > (newGain);
+    gain            = static_cast< SampleType > (newGain);
+    coefsNeedUpdate = true;
 }
 
 template < typename SampleType >
 float Filter< SampleType >::getGain() const
 {
-    return static_cast< float > (gain);
+    return static_cast< float > (gain.load());
 }
 
 template class Filter< float >;
@@ -35,16 +35,33 @@ public:
     void  setGain (float newGain);
     float getGain() const;
 
+    /* A bypassed filter leaves its input untouched. */
+    void setBypassed (bool shouldBeBypassed);
+    bool isBypassed() const;
+
     void process (juce::AudioBuffer< SampleType >& audio) final;
     void prepare (double samplerate, int blocksize) final;
 
+    /* Recalculates the coefficients if any parameter has changed since they were last calculated. */
+    const filters::Coefficients< SampleType >& getCoefficients();
+
+    /* True if the current coefficients pass the signal through unchanged, e.g. a peak or shelf with a gain of 1. */
+    bool isUnity();
+
 private:
+    void updateCoefficients();
+
     filters::MultiFilter< SampleType, 2 > filter;
 
-    FilterType type {HighPass};
-    SampleType freq {static_cast< SampleType > (440.)};
-    SampleType Q {static_cast< SampleType > (0.70710678118654752440L)};
-    SampleType gain {static_cast< SampleType > (1.)};
+    bool bypassed {false};
+
+    // the parameters are set from the message thread and read by updateCoefficients() on the audio thread
+    std::atomic< bool > coefsNeedUpdate {true};
+
+    std::atomic< FilterType > type {HighPass};
+    std::atomic< SampleType > freq {static_cast< SampleType > (440.)};
+    std::atomic< SampleType > Q {static_cast< SampleType > (0.70710678118654752440L)};
+    std::atomic< SampleType > gain {static_cast< SampleType > (1.)};
 
     double sampleRate {44100.};
 };
@@ -0,0 +1,520 @@
+
+namespace bav::dsp
+{
+template < typename SampleType >
+struct FxGraph< SampleType >::Schedule
+{
+    enum NodeState
+    {
+        Waiting,
+        Running,  // being rendered, by the audio thread or by a worker
+        Done
+    };
+
+    // a source of -1 is the graph's input; otherwise it's the index of a node in the schedule
+    static constexpr int graphInput = -1;
+
+    struct Input
+    {
+        int        source;
+        SampleType gain;
+    };
+
+    struct ScheduledNode
+    {
+        Effect* effect     = nullptr;
+        bool    isBypassed = false;
+
+        std::vector< Input > inputs;
+        std::vector< int >   dependents;
+        int                  numDependencies = 0;
+
+        AudioBuffer buffer;
+
+        std::atomic< int > dependenciesLeft {0};
+        std::atomic< int > state {Waiting};
+    };
+
+    explicit Schedule (size_t numNodes) : nodes (numNodes) { }
+
+    const AudioBuffer& getSource (int source) const
+    {
+        return source == graphInput ? *chunkInput : nodes[static_cast< size_t > (source)].buffer;
+    }
+
+    // sums a node's inputs into its buffer, then processes it
+    void renderNode (ScheduledNode& node);
+
+    // in dependency order: every node comes after all the nodes connected to its input
+    std::vector< ScheduledNode > nodes;
+
+    std::vector< Input > outputs;
+    AudioBuffer          outputBuffer;
+
+    // the most nodes that can ever be rendered at once
+    int maxWidth = 1;
+
+    // set by the audio thread before each chunk
+    const AudioBuffer* chunkInput = nullptr;
+    int                numChannels = 0, numSamples = 0;
+    std::atomic< int > nodesLeft {0};
+
+    // effects that were removed from the graph while this schedule was current, deleted along with it
+    std::vector< std::unique_ptr< Effect > > removedEffects;
+};
+
+template < typename SampleType >
+void FxGraph< SampleType >::Schedule::renderNode (ScheduledNode& node)
+{
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        node.buffer.clear (ch, 0, numSamples);
+
+        for (const auto& input : node.inputs)
+            node.buffer.addFrom (ch, 0, getSource (input.source), ch, 0, numSamples, input.gain);
+    }
+
+    if (node.isBypassed)
+    {
+        node.effect->fxChain_bypassedBlock (numSamples);
+        return;
+    }
+
+    AudioBuffer alias {node.buffer.getArrayOfWritePointers(), numChannels, numSamples};
+    node.effect->fxChain_process (alias);
+}
+
+/*--------------------------------------------------------------------------------------------------------------*/
+
+template < typename SampleType >
+class FxGraph< SampleType >::Worker : public juce::Thread
+{
+public:
+    explicit Worker (FxGraph& graph)
+        : juce::Thread ("FX graph worker"), owner (graph)
+    {
+    }
+
+    void run() final
+    {
+        while (! threadShouldExit())
+        {
+            owner.chunkStarted.wait();
+
+            // the audio thread won't finish the chunk, and release its schedule, while any worker is busy
+            owner.numBusyWorkers.fetch_add (1);
+
+            if (auto* schedule = owner.activeSchedule.load())
+                owner.helpRender (*schedule);
+
+            owner.numBusyWorkers.fetch_sub (1);
+        }
+    }
+
+private:
+    FxGraph& owner;
+};
+
+/*--------------------------------------------------------------------------------------------------------------*/
+
+template < typename SampleType >
+FxGraph< SampleType >::FxGraph (int numWorkerThreads)
+{
+    nodes[inputNode];
+    nodes[outputNode];
+
+    for (int i = 0; i < numWorkerThreads; ++i)
+    {
+        workers.push_back (std::make_unique< Worker > (*this));
+
+        // the audio thread waits for the workers at the end of every chunk, so they mustn't be preempted by anything it would preempt
+        workers.back()->startThread (10);
+    }
+}
+
+template < typename SampleType >
+FxGraph< SampleType >::~FxGraph()
+{
+    for (auto& worker : workers)
+        worker->signalThreadShouldExit();
+
+    chunkStarted.signal (static_cast< int > (workers.size()));
+
+    for (auto& worker : workers)
+        worker->stopThread (-1);
+}
+
+template < typename SampleType >
+int FxGraph< SampleType >::addEffect (Effect* effect, bool addAsBypassed)
+{
+    jassert (effect != nullptr);
+
+    const auto nodeID = nextNodeID++;
+
+    auto& node      = nodes[nodeID];
+    node.isBypassed = addAsBypassed;
+    node.effect.reset (effect);
+
+    if (lastSamplerate > 0.0 && lastBlocksize > 0)
+        effect->fxChain_prepare (lastSamplerate, lastBlocksize);
+
+    publishSchedule();
+    return nodeID;
+}
+
+template < typename SampleType >
+void FxGraph< SampleType >::removeEffect (int nodeID)
+{
+    if (getEffect (nodeID) == nullptr) return;
+
+    // the audio thread may still be processing the effect, so it is deleted along with the schedule it is in
+    pendingRemovals.push_back (std::move (nodes[nodeID].effect));
+    nodes.erase (nodeID);
+
+    for (auto& pair : nodes)
+        pair.second.inputs.erase (nodeID);
+
+    publishSchedule();
+}
+
+template < typename SampleType >
+void FxGraph< SampleType >::removeAllEffects()
+{
+    for (auto& pair : nodes)
+        if (pair.second.effect != nullptr)
+            pendingRemovals.push_back (std::move (pair.second.effect));
+
+    nodes.clear();
+    nodes[inputNode];
+    nodes[outputNode];
+
+    publishSchedule();
+}
+
+template < typename SampleType >
+ReorderableEffect< SampleType >* FxGraph< SampleType >::getEffect (int nodeID)
+{
+    const auto node = nodes.find (nodeID);
+
+    if (node == nodes.end()) return nullptr;
+
+    return node->second.effect.get();
+}
+
+template < typename SampleType >
+bool FxGraph< SampleType >::connect (int sourceNodeID, int destNodeID, SampleType gain)
+{
+    if (sourceNodeID == outputNode || destNodeID == inputNode || sourceNodeID == destNodeID) return false;
+
+    if (nodes.find (sourceNodeID) == nodes.end() || nodes.find (destNodeID) == nodes.end()) return false;
+
+    if (isReachable (destNodeID, sourceNodeID)) return false;
+
+    nodes[destNodeID].inputs[sourceNodeID] = gain;
+
+    publishSchedule();
+    return true;
+}
+
+template < typename SampleType >
+bool FxGraph< SampleType >::disconnect (int sourceNodeID, int destNodeID)
+{
+    const auto dest = nodes.find (destNodeID);
+
+    if (dest == nodes.end() || dest->second.inputs.erase (sourceNodeID) == 0) return false;
+
+    publishSchedule();
+    return true;
+}
+
+template < typename SampleType >
+bool FxGraph< SampleType >::isConnected (int sourceNodeID, int destNodeID) const
+{
+    const auto dest = nodes.find (destNodeID);
+
+    if (dest == nodes.end()) return false;
+
+    return dest->second.inputs.find (sourceNodeID) != dest->second.inputs.end();
+}
+
+template < typename SampleType >
+bool FxGraph< SampleType >::setEffectBypass (int nodeID, bool shouldBeBypassed)
+{
+    if (getEffect (nodeID) == nullptr) return false;
+
+    nodes[nodeID].isBypassed = shouldBeBypassed;
+
+    publishSchedule();
+    return true;
+}
+
+template < typename SampleType >
+int FxGraph< SampleType >::numEffects() const noexcept
+{
+    return static_cast< int > (nodes.size()) - 2;
+}
+
+template < typename SampleType >
+void FxGraph< SampleType >::prepare (double samplerate, int blocksize, int numChannels)
+{
+    jassert (samplerate > 0.0 && blocksize > 0 && numChannels > 0);
+
+    lastSamplerate  = samplerate;
+    lastBlocksize   = blocksize;
+    lastNumChannels = numChannels;
+
+    for (auto& pair : nodes)
+        if (auto* effect = pair.second.effect.get())
+            effect->fxChain_prepare (samplerate, blocksize);
+
+    publishSchedule();
+}
+
+template < typename SampleType >
+void FxGraph< SampleType >::process (AudioBuffer& audio)
+{
+    jassert (lastSamplerate > 0.0 && lastBlocksize > 0);
+
+    const auto numSamples  = audio.getNumSamples();
+    const auto numChannels = std::min (audio.getNumChannels(), lastNumChannels);
+
+    for (int ch = numChannels; ch < audio.getNumChannels(); ++ch)
+        audio.clear (ch, 0, numSamples);
+
+    auto* schedule = schedules.acquire();
+
+    if (schedule == nullptr || numChannels == 0)
+    {
+        schedules.release();
+        return;
+    }
+
+    for (int start = 0; start < numSamples; start += lastBlocksize)
+    {
+        AudioBuffer chunk {audio.getArrayOfWritePointers(), numChannels, start, std::min (lastBlocksize, numSamples - start)};
+        renderChunk (*schedule, chunk);
+    }
+
+    schedules.release();
+}
+
+template < typename SampleType >
+void FxGraph< SampleType >::bypassedBlock (int numSamples)
+{
+    if (auto* schedule = schedules.acquire())
+        for (auto& node : schedule->nodes)
+            node.effect->fxChain_bypassedBlock (numSamples);
+
+    schedules.release();
+}
+
+template < typename SampleType >
+void FxGraph< SampleType >::renderChunk (Schedule& schedule, AudioBuffer& audio)
+{
+    schedule.chunkInput  = &audio;
+    schedule.numChannels = audio.getNumChannels();
+    schedule.numSamples  = audio.getNumSamples();
+
+    for (auto& node : schedule.nodes)
+    {
+        node.dependenciesLeft.store (node.numDependencies, std::memory_order_relaxed);
+        node.state.store (Schedule::Waiting, std::memory_order_relaxed);
+    }
+
+    schedule.nodesLeft.store (static_cast< int > (schedule.nodes.size()), std::memory_order_release);
+
+    // a serial stretch of the graph gains nothing from waking the workers
+    const auto numHelpers = std::min (static_cast< int > (workers.size()), schedule.maxWidth - 1);
+
+    if (numHelpers > 0)
+    {
+        activeSchedule.store (&schedule);
+        chunkStarted.signal (numHelpers);
+    }
+
+    helpRender (schedule);
+
+    // Every node is done by now, so a worker still counted as busy is only on its way out of helpRender(), or just woke up and is about to see that no schedule is active.
+    // This spin is short because the workers run at the same priority as the audio thread.
+    if (numHelpers > 0)
+    {
+        activeSchedule.store (nullptr);
+
+        while (numBusyWorkers.load() > 0)
+            juce::Thread::yield();
+    }
+
+    // the output is summed apart from the audio, which the graph's input may still be feeding into it
+    for (int ch = 0; ch < schedule.numChannels; ++ch)
+    {
+        schedule.outputBuffer.clear (ch, 0, schedule.numSamples);
+
+        for (const auto& output : schedule.outputs)
+            schedule.outputBuffer.addFrom (ch, 0, schedule.getSource (output.source), ch, 0, schedule.numSamples, output.gain);
+
+        audio.copyFrom (ch, 0, schedule.outputBuffer, ch, 0, schedule.numSamples);
+    }
+}
+
+template < typename SampleType >
+void FxGraph< SampleType >::helpRender (Schedule& schedule)
+{
+    while (schedule.nodesLeft.load (std::memory_order_acquire) > 0)
+        if (! renderNextNode (schedule))
+            juce::Thread::yield();
+}
+
+template < typename SampleType >
+bool FxGraph< SampleType >::renderNextNode (Schedule& schedule)
+{
+    for (auto& node : schedule.nodes)
+    {
+        if (node.state.load (std::memory_order_relaxed) != Schedule::Waiting
+            || node.dependenciesLeft.load (std::memory_order_acquire) > 0)
+            continue;
+
+        auto expected = static_cast< int > (Schedule::Waiting);
+
+        if (! node.state.compare_exchange_strong (expected, Schedule::Running, std::memory_order_acquire))
+            continue;
+
+        schedule.renderNode (node);
+
+        for (auto dependent : node.dependents)
+            schedule.nodes[static_cast< size_t > (dependent)].dependenciesLeft.fetch_sub (1, std::memory_order_acq_rel);
+
+        node.state.store (Schedule::Done, std::memory_order_release);
+        schedule.nodesLeft.fetch_sub (1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    return false;
+}
+
+template < typename SampleType >
+bool FxGraph< SampleType >::isReachable (int sourceNodeID, int destNodeID) const
+{
+    // searches backwards from the destination, through the inputs of each node
+    std::vector< int > toVisit {destNodeID};
+    std::set< int >    visited;
+
+    while (! toVisit.empty())
+    {
+        const auto nodeID = toVisit.back();
+        toVisit.pop_back();
+
+        if (nodeID == sourceNodeID) return true;
+
+        if (! visited.insert (nodeID).second) continue;
+
+        const auto node = nodes.find (nodeID);
+
+        if (node == nodes.end()) continue;
+
+        for (const auto& input : node->second.inputs)
+            toVisit.push_back (input.first);
+    }
+
+    return false;
+}
+
+template < typename SampleType >
+void FxGraph< SampleType >::publishSchedule()
+{
+    // Kahn's algorithm: a node is scheduled once every node connected to its input has been; the input node is always ready
+    std::map< int, int >                numUnscheduledInputs;
+    std::map< int, std::vector< int > > dependents;
+    std::map< int, int >                depth;
+
+    std::vector< int > order;
+
+    for (const auto& pair : nodes)
+    {
+        if (pair.second.effect == nullptr) continue;
+
+        auto& count = numUnscheduledInputs[pair.first];
+
+        for (const auto& input : pair.second.inputs)
+        {
+            if (input.first == inputNode) continue;
+
+            dependents[input.first].push_back (pair.first);
+            ++count;
+        }
+
+        if (count == 0) order.push_back (pair.first);
+    }
+
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        const auto nodeID = order[i];
+
+        for (auto dependent : dependents[nodeID])
+        {
+            depth[dependent] = std::max (depth[dependent], depth[nodeID] + 1);
+
+            if (--numUnscheduledInputs[dependent] == 0) order.push_back (dependent);
+        }
+    }
+
+    jassert (static_cast< int > (order.size()) == numEffects());
+
+    auto schedule = std::make_unique< Schedule > (order.size());
+
+    std::map< int, int > indexOf;
+    std::map< int, int > numNodesAtDepth;
+
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        indexOf[order[i]] = static_cast< int > (i);
+        schedule->maxWidth = std::max (schedule->maxWidth, ++numNodesAtDepth[depth[order[i]]]);
+    }
+
+    const auto toInput = [&indexOf] (const std::pair< const int, SampleType >& input)
+    {
+        const auto source = input.first == inputNode ? Schedule::graphInput : indexOf[input.first];
+        return typename Schedule::Input {source, input.second};
+    };
+
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        const auto& node      = nodes[order[i]];
+        auto&       scheduled = schedule->nodes[i];
+
+        scheduled.effect     = node.effect.get();
+        scheduled.isBypassed = node.isBypassed;
+
+        for (const auto& input : node.inputs)
+        {
+            scheduled.inputs.push_back (toInput (input));
+
+            if (input.first != inputNode)
+            {
+                schedule->nodes[static_cast< size_t > (indexOf[input.first])].dependents.push_back (static_cast< int > (i));
+                ++scheduled.numDependencies;
+            }
+        }
+
+        scheduled.buffer.setSize (lastNumChannels, lastBlocksize);
+    }
+
+    for (const auto& input : nodes[outputNode].inputs)
+        schedule->outputs.push_back (toInput (input));
+
+    schedule->outputBuffer.setSize (lastNumChannels, lastBlocksize);
+
+    schedules.publish (std::move (schedule), [this] (Schedule& replaced)
+                       {
+                           for (auto& effect : pendingRemovals)
+                               replaced.removedEffects.push_back (std::move (effect));
+                       });
+
+    // if no schedule was replaced, the audio thread has never seen these effects
+    pendingRemovals.clear();
+}
+
+
+template class FxGraph< float >;
+template class FxGraph< double >;
+
+}  // namespace bav::dsp
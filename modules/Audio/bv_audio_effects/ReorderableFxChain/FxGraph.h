@@ -0,0 +1,101 @@
+
+#pragma once
+
+namespace bav::dsp
+{
+/*
+     An effects graph that, unlike ReorderableFxChain, can split the signal into parallel branches, sum branches back together, and send a scaled copy of one branch to another.
+     Each effect is a node. A connection feeds a node's output, scaled by the connection's gain, into another node's input, and a node's input is the sum of everything connected to it. The graph's own input and output are the nodes inputNode and outputNode.
+     Every edit is made on the message thread, which sorts the graph into a schedule and publishes it to the audio thread the same way ReorderableFxChain publishes its processing order.
+     Every node renders into its own preallocated buffer, so branches that don't depend on each other are rendered at the same time by a pool of worker threads, with the audio thread taking part.
+     */
+template < typename SampleType >
+class FxGraph
+{
+    using Effect      = ReorderableEffect< SampleType >;
+    using AudioBuffer = juce::AudioBuffer< SampleType >;
+
+public:
+    static constexpr int inputNode  = 0;
+    static constexpr int outputNode = 1;
+
+    // starts numWorkerThreads threads to render parallel branches. With 0, the audio thread renders every node.
+    explicit FxGraph (int numWorkerThreads = 2);
+    virtual ~FxGraph();
+
+    /* All the functions that modify the graph must be called from the message thread. */
+
+    // adds an unconnected effect to the graph, which takes ownership of it. Returns the new node's ID.
+    int addEffect (Effect* effect, bool addAsBypassed = false);
+
+    // also removes all the node's connections.
+    void removeEffect (int nodeID);
+    void removeAllEffects();
+
+    Effect* getEffect (int nodeID);
+
+    // returns false if either node doesn't exist, or if the connection would create a feedback loop. Connecting two nodes that are already connected changes the gain of their connection.
+    bool connect (int sourceNodeID, int destNodeID, SampleType gain = SampleType (1));
+    bool disconnect (int sourceNodeID, int destNodeID);
+
+    bool isConnected (int sourceNodeID, int destNodeID) const;
+
+    bool setEffectBypass (int nodeID, bool shouldBeBypassed);
+
+    int numEffects() const noexcept;
+
+    // allocates every node's buffer, so call this from the message thread.
+    void prepare (double samplerate, int blocksize, int numChannels = 2);
+
+    /*
+            The top-level rendering callback that renders the whole graph.
+            Audio will be output in place; channels beyond the number the graph was prepared for are cleared.
+         */
+    void process (AudioBuffer& audio);
+    void bypassedBlock (int numSamples);
+
+private:
+    struct Schedule;
+    class Worker;
+
+    struct Node
+    {
+        std::unique_ptr< Effect > effect;
+        bool                      isBypassed = false;
+
+        // source node ID -> gain
+        std::map< int, SampleType > inputs;
+    };
+
+    // returns true if there is a path of connections from the source to the destination.
+    bool isReachable (int sourceNodeID, int destNodeID) const;
+
+    // sorts the graph into a new schedule and publishes it to the audio thread
+    void publishSchedule();
+
+    void renderChunk (Schedule& schedule, AudioBuffer& audio);
+
+    // called by the audio thread and the workers while a chunk is rendering
+    void helpRender (Schedule& schedule);
+    bool renderNextNode (Schedule& schedule);
+
+    double lastSamplerate = 0.0;
+    int    lastBlocksize = 0, lastNumChannels = 0;
+
+    std::map< int, Node > nodes;
+    int                   nextNodeID = outputNode + 1;
+
+    realtime::SnapshotHandoff< Schedule >    schedules;
+    std::vector< std::unique_ptr< Effect > > pendingRemovals;
+
+    std::vector< std::unique_ptr< Worker > > workers;
+
+    // the schedule the workers should help with, set only while the audio thread is rendering a chunk
+    std::atomic< Schedule* > activeSchedule {nullptr};
+    std::atomic< int >       numBusyWorkers {0};
+
+    // signalled once for each worker needed for a chunk; the workers spin on it for a while before parking, so they stay awake between the chunks of a block
+    realtime::Semaphore chunkStarted;
+};
+
+}  // namespace bav::dsp
@@ -5,6 +5,10 @@ template class ReorderableEffect< float >;
 template class ReorderableEffect< double >;
 
 
+template < typename SampleType >
+ReorderableFxChain< SampleType >::~ReorderableFxChain() = default;
+
+
 template < typename SampleType >
 int ReorderableFxChain< SampleType >::addEffect (Effect* effect,
                                                  int     numberInChain,
@@ -62,7 +66,13 @@ int ReorderableFxChain< SampleType >::addEffectBetweenTwoOthers (Effect* effectT
 template < typename SampleType >
 void ReorderableFxChain< SampleType >::removeEffect (Effect* effect)
 {
-    effects.removeObject (effect, true);
+    if (effect == nullptr || ! effects.contains (effect)) return;
+
+    // the audio thread may still be processing the effect, so it is deleted along with the snapshot it is in
+    effects.removeObject (effect, false);
+    pendingRemovals.emplace_back (effect);
+
+    publishSnapshot();
 }
 
 template < typename SampleType >
@@ -74,7 +84,12 @@ void ReorderableFxChain< SampleType >::removeEffect (int numberInChain)
 template < typename SampleType >
 void ReorderableFxChain< SampleType >::removeAllEffects()
 {
-    effects.clear();
+    for (auto* effect : effects)
+        pendingRemovals.emplace_back (effect);
+
+    effects.clear (false);
+
+    publishSnapshot();
 }
 
 
@@ -97,6 +112,8 @@ bool ReorderableFxChain< SampleType >::swapTwoEffects (Effect* first, Effect* se
     const auto initNum   = first->effectNumber;
     first->effectNumber  = second->effectNumber;
     second->effectNumber = initNum;
+
+    publishSnapshot();
     return true;
 }
 
@@ -139,6 +156,8 @@ bool ReorderableFxChain< SampleType >::setEffectBypass (Effect* effect, bool sho
     if (effect == nullptr) return false;
 
     effect->isBypassed = shouldBeBypassed;
+
+    publishSnapshot();
     return true;
 }
 
@@ -170,6 +189,8 @@ void ReorderableFxChain< SampleType >::bypassAll()
 {
     for (auto* effect : effects)
         effect->isBypassed = true;
+
+    publishSnapshot();
 }
 
 template < typename SampleType >
@@ -177,6 +198,8 @@ void ReorderableFxChain< SampleType >::unBypassAll()
 {
     for (auto* effect : effects)
         effect->isBypassed = false;
+
+    publishSnapshot();
 }
 
 template < typename SampleType >
@@ -194,30 +217,58 @@ void ReorderableFxChain< SampleType >::prepare (double samplerate, int blocksize
 template < typename SampleType >
 void ReorderableFxChain< SampleType >::process (AudioBuffer& audio)
 {
-    jassert (! effects.isEmpty());
     jassert (lastSamplerate > 0.0 && lastBlocksize > 0);
 
     const auto numSamples = audio.getNumSamples();
 
     audio.clear();
 
-    for (int i = 0; i < effects.size(); ++i)
+    if (auto* snapshot = snapshots.acquire())
     {
-        if (auto* effect = getEffect (i))
+        for (const auto& step : snapshot->steps)
         {
-            if (effect->isBypassed)
-                effect->fxChain_bypassedBlock (numSamples);
+            if (step.isBypassed)
+                step.effect->fxChain_bypassedBlock (numSamples);
             else
-                effect->fxChain_process (audio);
+                step.effect->fxChain_process (audio);
         }
     }
+
+    snapshots.release();
 }
 
 template < typename SampleType >
 void ReorderableFxChain< SampleType >::bypassedBlock (int numSamples)
 {
+    if (auto* snapshot = snapshots.acquire())
+        for (const auto& step : snapshot->steps)
+            step.effect->fxChain_bypassedBlock (numSamples);
+
+    snapshots.release();
+}
+
+template < typename SampleType >
+void ReorderableFxChain< SampleType >::publishSnapshot()
+{
+    auto snapshot = std::make_unique< Snapshot >();
+
+    snapshot->steps.reserve (static_cast< size_t > (effects.size()));
+
     for (auto* effect : effects)
-        effect->fxChain_bypassedBlock (numSamples);
+        snapshot->steps.push_back ({effect, effect->isBypassed});
+
+    std::stable_sort (snapshot->steps.begin(), snapshot->steps.end(),
+                      [] (const Step& a, const Step& b)
+                      { return a.effect->effectNumber < b.effect->effectNumber; });
+
+    snapshots.publish (std::move (snapshot), [this] (Snapshot& replaced)
+                       {
+                           for (auto& effect : pendingRemovals)
+                               replaced.removedEffects.push_back (std::move (effect));
+                       });
+
+    // if no snapshot was replaced, the audio thread has never seen these effects
+    pendingRemovals.clear();
 }
 
 template < typename SampleType >
@@ -269,7 +320,9 @@ void ReorderableFxChain< SampleType >::addEffectWithNumber (Effect* effect, int
     jassert (getEffect (newNumber) != nullptr);
 
     if (lastSamplerate > 0.0 && lastBlocksize > 0)
-        getEffect (newNumber)->fxChain_prepare (lastSamplerate, lastBlocksize);
+        effect->fxChain_prepare (lastSamplerate, lastBlocksize);
+
+    publishSnapshot();
 }
 
 template < typename SampleType >
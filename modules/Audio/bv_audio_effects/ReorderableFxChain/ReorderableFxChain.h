@@ -4,10 +4,13 @@
 
 namespace bav::dsp
 {
-/// forward declaration...
+/// forward declarations...
 template < typename SampleType >
 class ReorderableFxChain;
 
+template < typename SampleType >
+class FxGraph;
+
 
 /*
      This base class defines the basic interface any processor must use to be a member of a reorderable FX chain.
@@ -37,6 +40,7 @@ protected:
 
 private:
     friend class ReorderableFxChain< SampleType >;
+    friend class FxGraph< SampleType >;
 
     int  effectNumber;
     bool isBypassed = false;
@@ -45,6 +49,8 @@ private:
 
 /*
      Base class for an engine object that owns and manages a series of individual effects processors, and can reorder them dynamically.
+     Every change to the chain is made on the message thread, which then publishes an immutable snapshot of the processing order (effect pointers and bypass flags) to the audio thread with an atomic pointer swap. The audio thread never touches the list of effects itself, so reordering can't race with processing.
+     Replaced snapshots, and any effects removed along with them, are deleted on the message thread once the audio thread has stopped using them.
      */
 template < typename SampleType >
 class ReorderableFxChain
@@ -53,8 +59,10 @@ class ReorderableFxChain
     using AudioBuffer = juce::AudioBuffer< SampleType >;
 
 public:
-    ReorderableFxChain()          = default;
-    virtual ~ReorderableFxChain() = default;
+    ReorderableFxChain() = default;
+    virtual ~ReorderableFxChain();
+
+    /* All the functions that modify the chain must be called from the message thread. */
 
     // adds an effect to the chain. Returns the actual number in the chain that the effect was placed in. (Doesn't move anything in the chain around.)
     int addEffect (Effect* effect,
@@ -103,6 +111,23 @@ public:
     void bypassedBlock (int numSamples);
 
 private:
+    struct Step
+    {
+        Effect* effect;
+        bool    isBypassed;
+    };
+
+    struct Snapshot
+    {
+        std::vector< Step > steps;
+
+        // effects that were removed from the chain while this snapshot was current, deleted along with it
+        std::vector< std::unique_ptr< Effect > > removedEffects;
+    };
+
+    // builds a snapshot of the current order and publishes it to the audio thread
+    void publishSnapshot();
+
     // if the current effect number is out of range or taken, attempts to return the closest availabe effect number to the passed number.
     int assignNewEffectNumber (int requestedNumber);
 
@@ -113,13 +138,13 @@ private:
 
     int highestCurrentEffectNumber();
 
-    /*
-        */
-
     double lastSamplerate = 0.0;
     int    lastBlocksize  = 0;
 
     juce::OwnedArray< Effect > effects;
+
+    realtime::SnapshotHandoff< Snapshot >    snapshots;
+    std::vector< std::unique_ptr< Effect > > pendingRemovals;
 };
 
 }  // namespace bav::dsp
@@ -3,19 +3,26 @@
 #include "AudioEffects/AudioEffect.cpp"
 #include "AudioEffects/AudioEffectManager.cpp"
 #include "ReorderableFxChain/ReorderableFxChain.cpp"
+#include "ReorderableFxChain/FxGraph.cpp"
 
+#include "dynamics/EnvelopeFollower.cpp"
 #include "dynamics/Compressor.cpp"
 #include "dynamics/Limiter.cpp"
 #include "dynamics/NoiseGate.cpp"
 #include "dynamics/SmoothedGain.cpp"
 #include "misc/DeEsser.cpp"
 #include "misc/DryWet.cpp"
+#include "misc/Freeverb.cpp"
+#include "misc/FDNReverb.cpp"
 #include "misc/Reverb.cpp"
 #include "stereo_image/MonoStereoConverter.cpp"
 #include "stereo_image/panning/MonoToStereoPanner.cpp"
 #include "stereo_image/panning/StereoPanner.cpp"
 #include "stereo_image/panning/PannerBase.cpp"
+#include "time/DelayLine.cpp"
 #include "time/Delay.cpp"
+#include "convolution/PartitionedConvolver.cpp"
+#include "convolution/Convolution.cpp"
 
 #include "EQ/Filter.cpp"
 #include "EQ/EQ.cpp"
@@ -9,7 +9,7 @@ vendor:             Ben Vining
 version:            0.0.1
 name:               bv_audio_effects
 description:        DSP effects for plugin development
-dependencies:       bv_dsp
+dependencies:       bv_dsp bv_serializing
 
 END_JUCE_MODULE_DECLARATION
 
@@ -18,13 +18,17 @@ END_JUCE_MODULE_DECLARATION
 #include "AudioEffects/AudioEffect.h"
 #include "AudioEffects/AudioEffectManager.h"
 #include "ReorderableFxChain/ReorderableFxChain.h"
+#include "ReorderableFxChain/FxGraph.h"
 
+#include "dynamics/EnvelopeFollower.h"
 #include "dynamics/SmoothedGain.h"
 #include "dynamics/NoiseGate.h"
 #include "dynamics/Compressor.h"
 #include "dynamics/Limiter.h"
 
 #include "misc/DeEsser.h"
+#include "misc/Freeverb.h"
+#include "misc/FDNReverb.h"
 #include "misc/Reverb.h"
 #include "misc/DryWet.h"
 
@@ -32,7 +36,11 @@ END_JUCE_MODULE_DECLARATION
 #include "stereo_image/panning/MonoToStereoPanner.h"
 #include "stereo_image/panning/StereoPanner.h"
 
+#include "time/DelayLine.h"
 #include "time/Delay.h"
 
+#include "convolution/PartitionedConvolver.h"
+#include "convolution/Convolution.h"
+
 #include "EQ/Filter.h"
 #include "EQ/EQ.h"
@@ -0,0 +1,153 @@
+
+namespace bav::dsp::FX
+{
+template < typename SampleType >
+Convolution< SampleType >::Convolution()
+{
+    setDryWet (100);
+}
+
+template < typename SampleType >
+Convolution< SampleType >::~Convolution() = default;
+
+template < typename SampleType >
+void Convolution< SampleType >::prepare (double samplerate, int blocksize)
+{
+    jassert (samplerate > 0. && blocksize > 0);
+
+    dryBuffer.setSize (maxChannels, blocksize, true, true, true);
+    fadeBuffer.setSize (maxChannels, blocksize, true, true, true);
+
+    dryGain.prepare (samplerate, blocksize);
+    wetGain.prepare (samplerate, blocksize);
+
+    // a standby convolver left over from a finished switch isn't needed anymore
+    if (switchState.load (std::memory_order_acquire) == Idle)
+        engines[1 - activeSlot.load (std::memory_order_acquire)].reset();
+
+    reset();
+}
+
+template < typename SampleType >
+void Convolution< SampleType >::reset()
+{
+    for (auto& engine : engines)
+        if (engine != nullptr)
+            engine->reset();
+
+    dryGain.reset();
+    wetGain.reset();
+}
+
+template < typename SampleType >
+void Convolution< SampleType >::loadImpulseResponse (const AudioBuffer& newImpulseResponse)
+{
+    // take back the standby slot: cancel a switch the audio thread hasn't started yet, or wait out one it's in the middle of
+    for (auto state = switchState.load (std::memory_order_acquire);
+         state != Idle;
+         state = switchState.load (std::memory_order_acquire))
+    {
+        if (state == Pending && switchState.compare_exchange_strong (state, Idle, std::memory_order_acq_rel))
+            break;
+
+        juce::Thread::yield();
+    }
+
+    impulseResponse.makeCopyOf (newImpulseResponse);
+
+    // any convolver left in the standby slot is destroyed here, off the audio thread
+    engines[1 - activeSlot.load (std::memory_order_acquire)] = std::make_unique< Engine > (impulseResponse, maxChannels);
+
+    switchState.store (Pending, std::memory_order_release);
+}
+
+template < typename SampleType >
+void Convolution< SampleType >::loadImpulseResponse (const juce::var& serializedImpulseResponse)
+{
+    loadImpulseResponse (fromVar< AudioBuffer > (serializedImpulseResponse));
+}
+
+template < typename SampleType >
+juce::var Convolution< SampleType >::getSerializedImpulseResponse()
+{
+    return toVar (impulseResponse);
+}
+
+template < typename SampleType >
+void Convolution< SampleType >::setDryWet (int wetMixPercent)
+{
+    const auto wet = static_cast< float > (wetMixPercent) * 0.01f;
+    wetGain.setGain (wet);
+    dryGain.setGain (1.0f - wet);
+}
+
+template < typename SampleType >
+void Convolution< SampleType >::process (AudioBuffer& audio)
+{
+    const auto numChannels = std::min (audio.getNumChannels(), maxChannels);
+    const auto numSamples  = audio.getNumSamples();
+
+    if (numChannels == 0) return;
+
+    jassert (numSamples <= dryBuffer.getNumSamples());
+
+    AudioBuffer wet {audio.getArrayOfWritePointers(), numChannels, numSamples};
+    AudioBuffer dry {dryBuffer.getArrayOfWritePointers(), numChannels, numSamples};
+
+    for (int chan = 0; chan < numChannels; ++chan)
+        vecops::copy (wet.getReadPointer (chan), dry.getWritePointer (chan), numSamples);
+
+    auto expected = static_cast< int > (Pending);
+
+    if (switchState.compare_exchange_strong (expected, Switching, std::memory_order_acquire))
+    {
+        const auto oldSlot = activeSlot.load (std::memory_order_relaxed);
+        const auto newSlot = 1 - oldSlot;
+
+        AudioBuffer incoming {fadeBuffer.getArrayOfWritePointers(), numChannels, numSamples};
+
+        for (int chan = 0; chan < numChannels; ++chan)
+            vecops::copy (wet.getReadPointer (chan), incoming.getWritePointer (chan), numSamples);
+
+        if (engines[oldSlot] != nullptr)
+            engines[oldSlot]->process (wet);
+        else
+            wet.clear();
+
+        engines[newSlot]->process (incoming);
+
+        // linear crossfade from the outgoing convolver to the new one
+        const auto step = SampleType (1) / static_cast< SampleType > (numSamples);
+
+        for (int chan = 0; chan < numChannels; ++chan)
+        {
+            auto*       out = wet.getWritePointer (chan);
+            const auto* in  = incoming.getReadPointer (chan);
+
+            for (int i = 0; i < numSamples; ++i)
+                out[i] += (in[i] - out[i]) * step * static_cast< SampleType > (i + 1);
+        }
+
+        activeSlot.store (newSlot, std::memory_order_relaxed);
+        switchState.store (Idle, std::memory_order_release);
+    }
+    else if (auto& engine = engines[activeSlot.load (std::memory_order_relaxed)]; engine != nullptr)
+    {
+        engine->process (wet);
+    }
+    else
+    {
+        wet.clear();
+    }
+
+    dryGain.process (dry);
+    wetGain.process (wet);
+
+    for (int chan = 0; chan < numChannels; ++chan)
+        vecops::addV (wet.getWritePointer (chan), dry.getReadPointer (chan), numSamples);
+}
+
+template class Convolution< float >;
+template class Convolution< double >;
+
+}  // namespace bav::dsp::FX
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <bv_serializing/bv_serializing.h>
+
+namespace bav::dsp::FX
+{
+/*
+    A zero-latency convolution effect for long impulse responses, such as reverbs.
+    Loading an IR partitions it into a new convolver in a standby slot; the audio thread then crossfades to it over its next block.
+    The IR is used at the processing samplerate, and up to 2 channels are convolved, each with its own IR channel when the IR has them.
+*/
+template < typename SampleType >
+class Convolution : public AudioEffect< SampleType >, public ReorderableEffect< SampleType >
+{
+public:
+    using AudioBuffer = juce::AudioBuffer< SampleType >;
+
+    Convolution();
+    ~Convolution() override;
+
+    void prepare (double samplerate, int blocksize) final;
+    void process (AudioBuffer& audio) final;
+
+    /* Clears the convolution tails. */
+    void reset();
+
+    /* These allocate and partition the new IR, so call them from the message thread. */
+    void loadImpulseResponse (const AudioBuffer& impulseResponse);
+    void loadImpulseResponse (const juce::var& serializedImpulseResponse);
+
+    /* The current IR, in the format loadImpulseResponse() accepts. */
+    juce::var getSerializedImpulseResponse();
+
+    int getImpulseResponseLength() const { return impulseResponse.getNumSamples(); }
+
+    void setDryWet (int wetMixPercent);
+
+private:
+    using Engine = PartitionedConvolver< SampleType >;
+
+    void fxChain_process (AudioBuffer& audio) final { process (audio); }
+    void fxChain_prepare (double samplerate, int blocksize) final { prepare (samplerate, blocksize); }
+
+    static constexpr int maxChannels = 2;
+
+    enum SwitchState
+    {
+        Idle,
+        Pending,   // a new convolver is waiting in the standby slot
+        Switching  // the audio thread is crossfading to the standby slot
+    };
+
+    AudioBuffer impulseResponse;
+
+    std::unique_ptr< Engine > engines[2];
+    std::atomic< int >        activeSlot {0};
+    std::atomic< int >        switchState {Idle};
+
+    AudioBuffer dryBuffer, fadeBuffer;
+
+    SmoothedGain< SampleType, maxChannels > dryGain, wetGain;
+};
+
+}  // namespace bav::dsp::FX
@@ -0,0 +1,466 @@
+
+namespace bav::dsp::FX
+{
+template < typename SampleType >
+static void copyToFloatBuffer (const SampleType* source, float* dest, int numSamples)
+{
+    if constexpr (std::is_same_v< SampleType, float >)
+        vecops::copy (source, dest, numSamples);
+    else
+        vecops::convert (dest, source, numSamples);
+}
+
+template < typename SampleType >
+static void addFromFloatBuffer (SampleType* dest, const float* source, int numSamples)
+{
+    if constexpr (std::is_same_v< SampleType, float >)
+        vecops::addV (dest, source, numSamples);
+    else
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] += static_cast< SampleType > (source[i]);
+}
+
+/* sum += a * b, for interleaved complex spectra */
+static inline void complexMultiplyAccumulate (float* sum, const float* a, const float* b, int numBins) noexcept
+{
+    for (int k = 0; k < numBins; ++k)
+    {
+        const auto re = 2 * k, im = re + 1;
+
+        sum[re] += a[re] * b[re] - a[im] * b[im];
+        sum[im] += a[re] * b[im] + a[im] * b[re];
+    }
+}
+
+/*--------------------------------------------------------------------------------------------------------------*/
+
+template < typename SampleType >
+struct PartitionedConvolver< SampleType >::Stage
+{
+    enum JobStatus
+    {
+        Queued,   // waiting for the worker
+        Running,  // being computed, by the worker or by the audio thread at its deadline
+        Done
+    };
+
+    // a worker stage's job is due two partitions after it's launched, so two can be in flight at once
+    static constexpr int numJobSlots = 2;
+
+    Stage (const juce::AudioBuffer< float >& ir, int partition, int irOffset, int length, int numChannels, bool isThreaded);
+
+    /* Transforms the slot's input block, multiplies the spectrum history with the IR partitions, and writes the slot's block of output. Jobs must run in the order they were launched. */
+    void runJob (size_t slot) noexcept;
+
+    /* Job n lives in slot n % numJobSlots. Its number is packed into the slot's state along with its status, so a later job in the same slot can't be mistaken for it. */
+    static juce::int64 makeJobState (juce::int64 jobNumber, JobStatus status) noexcept { return jobNumber * 4 + status; }
+
+    juce::dsp::FFT fft;
+
+    const int  partitionSize, fftSize, spectrumSize, numPartitions;
+    const bool runsOnWorker;
+
+    struct Channel
+    {
+        std::vector< float > irSpectra, history;
+        std::vector< float > accumulated, previousBlock, output;
+
+        std::array< std::vector< float >, numJobSlots > jobInputs, jobOutputs;
+    };
+
+    std::vector< Channel > channels;
+    std::vector< float >   fftBuffer, spectrumSum;
+
+    int historyIndex {0};
+    int fill {0}, readPosition {0};
+
+    // only used by the audio thread
+    juce::int64 numJobsLaunched {0}, numJobsCollected {0};
+
+    std::array< int, numJobSlots >                        jobNumChannels {};
+    std::array< std::atomic< juce::int64 >, numJobSlots > jobStates;
+    std::atomic< juce::int64 >                            numJobsRun {0};  // also the number of the only job that may be started next
+};
+
+static int getFFTOrder (int fftSize)
+{
+    int order = 0;
+
+    while ((1 << order) < fftSize)
+        ++order;
+
+    return order;
+}
+
+template < typename SampleType >
+PartitionedConvolver< SampleType >::Stage::Stage (const juce::AudioBuffer< float >& ir, int partition, int irOffset, int length, int numChannels, bool isThreaded)
+    : fft (getFFTOrder (2 * partition)),
+      partitionSize (partition),
+      fftSize (2 * partition),
+      spectrumSize (2 * partition + 2),
+      numPartitions ((length + partition - 1) / partition),
+      runsOnWorker (isThreaded)
+{
+    // the FFT works in place, and its real-only transforms need room for a full complex result
+    fftBuffer.resize (static_cast< size_t > (fftSize * 2));
+    spectrumSum.resize (static_cast< size_t > (spectrumSize));
+
+    channels.resize (static_cast< size_t > (numChannels));
+
+    for (auto& state : jobStates)
+        state.store (makeJobState (-1, Done));
+
+    const auto historySize = static_cast< size_t > (numPartitions * spectrumSize);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto& chan = channels[static_cast< size_t > (ch)];
+
+        chan.irSpectra.resize (historySize);
+        chan.history.resize (historySize);
+        chan.accumulated.resize (static_cast< size_t > (partitionSize));
+        chan.previousBlock.resize (static_cast< size_t > (partitionSize));
+        chan.output.resize (static_cast< size_t > (partitionSize));
+
+        for (int slot = 0; slot < numJobSlots; ++slot)
+        {
+            chan.jobInputs[static_cast< size_t > (slot)].resize (static_cast< size_t > (fftSize));
+            chan.jobOutputs[static_cast< size_t > (slot)].resize (static_cast< size_t > (partitionSize));
+        }
+
+        const auto* taps = ir.getReadPointer (std::min (ch, ir.getNumChannels() - 1)) + irOffset;
+
+        // each partition is zero-padded to the FFT size, so that overlap-save keeps the last partitionSize samples
+        for (int p = 0; p < numPartitions; ++p)
+        {
+            const auto start = p * partitionSize;
+            const auto count = std::min (partitionSize, length - start);
+
+            std::fill (fftBuffer.begin(), fftBuffer.end(), 0.f);
+            vecops::copy (taps + start, fftBuffer.data(), count);
+
+            fft.performRealOnlyForwardTransform (fftBuffer.data(), true);
+
+            vecops::copy (fftBuffer.data(), chan.irSpectra.data() + p * spectrumSize, spectrumSize);
+        }
+    }
+}
+
+template < typename SampleType >
+void PartitionedConvolver< SampleType >::Stage::runJob (size_t slot) noexcept
+{
+    const auto numBins = spectrumSize / 2;
+
+    for (size_t ch = 0; ch < channels.size(); ++ch)
+    {
+        auto& chan = channels[ch];
+
+        auto* newest = chan.history.data() + historyIndex * spectrumSize;
+
+        // inactive channels get a silent input block, so that their history stays in step
+        if (static_cast< int > (ch) >= jobNumChannels[slot])
+        {
+            std::fill (newest, newest + spectrumSize, 0.f);
+            continue;
+        }
+
+        vecops::copy (chan.jobInputs[slot].data(), fftBuffer.data(), fftSize);
+        fft.performRealOnlyForwardTransform (fftBuffer.data(), true);
+        vecops::copy (fftBuffer.data(), newest, spectrumSize);
+
+        std::fill (spectrumSum.begin(), spectrumSum.end(), 0.f);
+
+        // partition p of the IR meets the input block from p blocks ago
+        for (int p = 0; p < numPartitions; ++p)
+        {
+            const auto historySlot = (historyIndex - p + numPartitions) % numPartitions;
+
+            complexMultiplyAccumulate (spectrumSum.data(),
+                                       chan.history.data() + historySlot * spectrumSize,
+                                       chan.irSpectra.data() + p * spectrumSize,
+                                       numBins);
+        }
+
+        vecops::copy (spectrumSum.data(), fftBuffer.data(), spectrumSize);
+        fft.performRealOnlyInverseTransform (fftBuffer.data());
+
+        vecops::copy (fftBuffer.data() + partitionSize, chan.jobOutputs[slot].data(), partitionSize);
+    }
+
+    historyIndex = (historyIndex + 1) % numPartitions;
+}
+
+/*--------------------------------------------------------------------------------------------------------------*/
+
+template < typename SampleType >
+class PartitionedConvolver< SampleType >::Worker : public juce::Thread
+{
+public:
+    explicit Worker (PartitionedConvolver& convolver)
+        : juce::Thread ("Convolution worker"), owner (convolver)
+    {
+    }
+
+    void run() final
+    {
+        while (! threadShouldExit())
+            if (! runNextJob())
+                jobsLaunched.wait();
+    }
+
+    /* Called by the audio thread after launching a job. */
+    void wake() noexcept { jobsLaunched.signal(); }
+
+    void stop()
+    {
+        signalThreadShouldExit();
+        wake();
+        stopThread (-1);
+    }
+
+private:
+    // The shortest partitions have the nearest deadlines, so the stages are always scanned from the smallest.
+    // Each stage's jobs are run in order, so only the job after the last one run can be started.
+    bool runNextJob()
+    {
+        for (auto& stage : owner.stages)
+        {
+            const auto jobNumber = stage->numJobsRun.load (std::memory_order_acquire);
+            const auto slot      = static_cast< size_t > (jobNumber % Stage::numJobSlots);
+
+            auto expected = Stage::makeJobState (jobNumber, Stage::Queued);
+
+            if (stage->jobStates[slot].compare_exchange_strong (expected, Stage::makeJobState (jobNumber, Stage::Running), std::memory_order_acquire))
+            {
+                stage->runJob (slot);
+                stage->numJobsRun.store (jobNumber + 1, std::memory_order_release);
+                stage->jobStates[slot].store (Stage::makeJobState (jobNumber, Stage::Done), std::memory_order_release);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    PartitionedConvolver& owner;
+    realtime::Semaphore   jobsLaunched;
+};
+
+/*--------------------------------------------------------------------------------------------------------------*/
+
+template < typename SampleType >
+PartitionedConvolver< SampleType >::PartitionedConvolver (const AudioBuffer& impulseResponse, int numChannelsToUse, bool useBackgroundThread)
+    : irLength (impulseResponse.getNumSamples()), numChannels (numChannelsToUse)
+{
+    jassert (numChannels > 0 && impulseResponse.getNumChannels() > 0);
+
+    const auto irChannels = impulseResponse.getNumChannels();
+
+    head.resize (static_cast< size_t > (numChannels));
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto& chan = head[static_cast< size_t > (ch)];
+
+        chan.taps.assign (static_cast< size_t > (headSize), SampleType (0));
+        chan.history.assign (static_cast< size_t > (2 * headSize - 1), SampleType (0));
+
+        vecops::copy (impulseResponse.getReadPointer (std::min (ch, irChannels - 1)), chan.taps.data(), std::min (headSize, irLength));
+    }
+
+    if (irLength <= headSize) return;
+
+    juce::AudioBuffer< float > ir {irChannels, irLength};
+
+    for (int ch = 0; ch < irChannels; ++ch)
+        copyToFloatBuffer (impulseResponse.getReadPointer (ch), ir.getWritePointer (ch), irLength);
+
+    // The first stage starts right after the head, and must be computed as soon as each of its blocks is complete.
+    // Every later stage starts 3 * partitionSize taps into the IR, so its output is due two whole partitions after its input block is complete: one to compute it in, and one more in case the worker falls behind.
+    for (int partition = headSize, offset = headSize; offset < irLength; partition = std::min (partition * growthFactor, maxPartitionSize))
+    {
+        const auto end = partition == maxPartitionSize ? irLength : std::min (irLength, 3 * growthFactor * partition);
+
+        stages.push_back (std::make_unique< Stage > (ir, partition, offset, end - offset, numChannels, offset >= 3 * partition));
+
+        offset = end;
+    }
+
+    if (useBackgroundThread && stages.back()->runsOnWorker)
+    {
+        worker = std::make_unique< Worker > (*this);
+        worker->startThread (10);  // realtime where the platform allows it, since the audio thread depends on its deadlines
+    }
+}
+
+template < typename SampleType >
+PartitionedConvolver< SampleType >::~PartitionedConvolver()
+{
+    if (worker != nullptr)
+        worker->stop();
+}
+
+template < typename SampleType >
+void PartitionedConvolver< SampleType >::reset()
+{
+    for (auto& stage : stages)
+    {
+        while (stage->numJobsCollected < stage->numJobsLaunched)
+            collectJob (*stage);
+
+        for (auto& chan : stage->channels)
+        {
+            for (auto* data : {&chan.history, &chan.accumulated, &chan.previousBlock, &chan.output})
+                std::fill (data->begin(), data->end(), 0.f);
+
+            for (int slot = 0; slot < Stage::numJobSlots; ++slot)
+                for (auto* data : {&chan.jobInputs[static_cast< size_t > (slot)], &chan.jobOutputs[static_cast< size_t > (slot)]})
+                    std::fill (data->begin(), data->end(), 0.f);
+        }
+
+        stage->historyIndex = 0;
+        stage->fill         = 0;
+        stage->readPosition = 0;
+    }
+
+    for (auto& chan : head)
+        std::fill (chan.history.begin(), chan.history.end(), SampleType (0));
+
+    headPhase = 0;
+}
+
+template < typename SampleType >
+void PartitionedConvolver< SampleType >::process (AudioBuffer& audio)
+{
+    const auto numActiveChannels = std::min (numChannels, audio.getNumChannels());
+    const auto numSamples        = audio.getNumSamples();
+
+    // the audio is processed in chunks that end on the head's block boundaries, where the FFT stages' blocks can end too
+    for (int pos = 0; pos < numSamples;)
+    {
+        const auto numThisChunk = std::min (numSamples - pos, headSize - headPhase);
+
+        for (int ch = 0; ch < numActiveChannels; ++ch)
+        {
+            auto* samples = audio.getWritePointer (ch) + pos;
+            auto& chan    = head[static_cast< size_t > (ch)];
+            auto* history = chan.history.data();
+
+            vecops::copy (samples, history + headSize - 1, numThisChunk);
+
+            for (auto& stage : stages)
+                copyToFloatBuffer (samples, stage->channels[static_cast< size_t > (ch)].accumulated.data() + stage->fill, numThisChunk);
+
+            // the head is a direct-form FIR, run one tap at a time across the chunk
+            vecops::fill (samples, SampleType (0), numThisChunk);
+
+            for (int tap = 0; tap < headSize; ++tap)
+                juce::FloatVectorOperations::addWithMultiply (samples, history + headSize - 1 - tap, chan.taps[static_cast< size_t > (tap)], numThisChunk);
+
+            std::copy (history + numThisChunk, history + numThisChunk + headSize - 1, history);
+
+            for (auto& stage : stages)
+                addFromFloatBuffer (samples, stage->channels[static_cast< size_t > (ch)].output.data() + stage->readPosition, numThisChunk);
+        }
+
+        for (auto& stage : stages)
+        {
+            stage->fill += numThisChunk;
+            stage->readPosition += numThisChunk;
+        }
+
+        pos += numThisChunk;
+        headPhase += numThisChunk;
+
+        if (headPhase == headSize)
+        {
+            headPhase = 0;
+
+            for (auto& stage : stages)
+                if (stage->fill == stage->partitionSize)
+                    endOfPartition (*stage, numActiveChannels);
+        }
+    }
+}
+
+template < typename SampleType >
+void PartitionedConvolver< SampleType >::endOfPartition (Stage& stage, int numActiveChannels)
+{
+    // the job launched two partitions ago is due now, and the next job reuses its slot
+    if (stage.numJobsLaunched - stage.numJobsCollected == Stage::numJobSlots)
+        collectJob (stage);
+
+    stage.readPosition = 0;
+
+    const auto slot = static_cast< size_t > (stage.numJobsLaunched % Stage::numJobSlots);
+    const auto size = static_cast< std::ptrdiff_t > (stage.partitionSize);
+
+    for (size_t ch = 0; ch < stage.channels.size(); ++ch)
+    {
+        auto& chan  = stage.channels[ch];
+        auto& input = chan.jobInputs[slot];
+
+        // overlap-save: the previous block, then the one that just finished
+        if (static_cast< int > (ch) < numActiveChannels)
+        {
+            std::copy (chan.previousBlock.begin(), chan.previousBlock.end(), input.begin());
+            std::copy (chan.accumulated.begin(), chan.accumulated.end(), input.begin() + size);
+            chan.previousBlock.swap (chan.accumulated);
+        }
+        else
+        {
+            std::fill (input.begin(), input.end(), 0.f);
+            std::fill (chan.previousBlock.begin(), chan.previousBlock.end(), 0.f);
+        }
+    }
+
+    stage.fill                 = 0;
+    stage.jobNumChannels[slot] = numActiveChannels;
+
+    if (! stage.runsOnWorker)
+    {
+        stage.runJob (slot);
+
+        for (auto& chan : stage.channels)
+            chan.output.swap (chan.jobOutputs[slot]);
+
+        return;
+    }
+
+    stage.jobStates[slot].store (Stage::makeJobState (stage.numJobsLaunched, Stage::Queued), std::memory_order_release);
+    ++stage.numJobsLaunched;
+
+    if (worker != nullptr)
+        worker->wake();
+}
+
+template < typename SampleType >
+void PartitionedConvolver< SampleType >::collectJob (Stage& stage)
+{
+    const auto jobNumber = stage.numJobsCollected++;
+    const auto slot      = static_cast< size_t > (jobNumber % Stage::numJobSlots);
+    auto&      state     = stage.jobStates[slot];
+
+    auto expected = Stage::makeJobState (jobNumber, Stage::Queued);
+
+    // A job the worker hasn't started by its deadline is computed here instead.
+    // The worker had a whole partition of slack, so finding the job still running means the worker is badly starved; only then does this wait.
+    if (state.compare_exchange_strong (expected, Stage::makeJobState (jobNumber, Stage::Running), std::memory_order_acquire))
+    {
+        stage.runJob (slot);
+        stage.numJobsRun.store (jobNumber + 1, std::memory_order_release);
+    }
+    else
+    {
+        while (state.load (std::memory_order_acquire) != Stage::makeJobState (jobNumber, Stage::Done))
+            juce::Thread::yield();
+    }
+
+    for (auto& chan : stage.channels)
+        chan.output.swap (chan.jobOutputs[slot]);
+}
+
+template class PartitionedConvolver< float >;
+template class PartitionedConvolver< double >;
+
+}  // namespace bav::dsp::FX
@@ -0,0 +1,58 @@
+#pragma once
+
+namespace bav::dsp::FX
+{
+/*
+    Zero-latency, non-uniformly partitioned convolution with a fixed impulse response.
+    The first headSize taps are applied directly in the time domain. The rest of the IR is split into FFT stages whose partitions grow by a factor of growthFactor, so a multi-second tail costs a few large FFTs instead of many small ones.
+    The first FFT stage is computed on the audio thread. Every later stage's output is due two partitions after its input block is complete, so it is handed to a background thread with a whole partition to spare. If that thread hasn't picked a job up by its deadline, the audio thread computes it itself, so the output never depends on thread timing.
+    The FFT stages run at float precision.
+*/
+template < typename SampleType >
+class PartitionedConvolver
+{
+public:
+    using AudioBuffer = juce::AudioBuffer< SampleType >;
+
+    static constexpr int headSize         = 64;
+    static constexpr int growthFactor     = 8;
+    static constexpr int maxPartitionSize = 32768;
+
+    /* Partitions the IR and starts the background thread, so create this on the message thread.
+       Channel N of the processed audio uses channel N of the IR, or its last channel if it has fewer. */
+    PartitionedConvolver (const AudioBuffer& impulseResponse, int numChannels, bool useBackgroundThread = true);
+    ~PartitionedConvolver();
+
+    /* Clears the convolution state. This waits for any jobs the background thread is working on. */
+    void reset();
+
+    /* Convolves the first numChannels channels of the audio in place. */
+    void process (AudioBuffer& audio);
+
+    int getImpulseResponseLength() const { return irLength; }
+    int getNumChannels() const { return numChannels; }
+    int getNumStages() const { return static_cast< int > (stages.size()); }
+
+private:
+    struct Stage;
+    class Worker;
+
+    void endOfPartition (Stage& stage, int numActiveChannels);
+
+    /* Finishes the oldest job in flight, computing it here if the worker hasn't started it, and swaps its output in. */
+    void collectJob (Stage& stage);
+
+    struct HeadChannel
+    {
+        std::vector< SampleType > taps, history;
+    };
+
+    std::vector< HeadChannel >               head;
+    std::vector< std::unique_ptr< Stage > > stages;
+    std::unique_ptr< Worker >               worker;
+
+    int irLength {0}, numChannels {0};
+    int headPhase {0};
+};
+
+}  // namespace bav::dsp::FX
@@ -4,7 +4,6 @@ namespace bav::dsp::FX
 template < typename SampleType >
 Compressor< SampleType >::Compressor()
 {
-    spec.numChannels = 2;
     update();
 }
 
@@ -13,10 +12,10 @@ void Compressor< SampleType >::prepare (double samplerate, int blocksize)
 {
     jassert (samplerate > 0);
 
-    spec.sampleRate       = samplerate;
-    spec.maximumBlockSize = static_cast< juce::uint32 > (blocksize);
+    sampleRate = samplerate;
 
-    envelopeFilter.prepare (spec);
+    envelopeFilter.prepare (samplerate);
+    gainBuffer.resize (static_cast< size_t > (blocksize));
 
     update();
     reset();
@@ -28,19 +27,25 @@ SampleType Compressor< SampleType >::processChannel (int               channel,
                                                      SampleType*       signalToCompress,
                                                      const SampleType* sidechain)
 {
-    if (numSamples == 0) return static_cast< SampleType > (0);
+    const auto chunkSize = static_cast< int > (gainBuffer.size());
 
-    SampleType avgGainReduction = 0;
-    SampleType gainRedux        = 0;
+    if (numSamples == 0 || chunkSize == 0) return static_cast< SampleType > (0);
 
-    for (int s = 0; s < numSamples; ++s)
+    auto* gains = gainBuffer.data();
+
+    SampleType totalGain = 0;
+
+    for (int start = 0; start < numSamples; start += chunkSize)
     {
-        signalToCompress[s] = processSample (channel, signalToCompress[s], sidechain[s], &gainRedux);
-        avgGainReduction += gainRedux;
+        const auto chunk = std::min (chunkSize, numSamples - start);
+
+        computeGain (channel, sidechain + start, gains, chunk);
+        vecops::multiplyV (signalToCompress + start, gains, chunk);
+
+        totalGain = std::accumulate (gains, gains + chunk, totalGain);
     }
 
-    avgGainReduction *= (1 / numSamples);
-    return avgGainReduction;
+    return totalGain / static_cast< SampleType > (numSamples);
 }
 
 template < typename SampleType >
@@ -49,13 +54,8 @@ SampleType Compressor< SampleType >::processSample (int         channel,
                                                     SampleType  sidechainSample,
                                                     SampleType* gainReduction)
 {
-    auto env = envelopeFilter.processSample (
-        channel, sidechainSample);  // Ballistics filter with peak rectifier
-
-    // VCA
-    auto gain = (env < threshold) ? SampleType (1.0)
-                                  : std::pow (env * thresholdInverse,
-                                              ratioInverse - SampleType (1.0));
+    SampleType gain;
+    computeGain (channel, &sidechainSample, &gain, 1);
 
     if (gainReduction != nullptr)  // report gain reduction, if requested
         *gainReduction = gain;
@@ -63,6 +63,18 @@ SampleType Compressor< SampleType >::processSample (int         channel,
     return gain * inputSample;
 }
 
+template < typename SampleType >
+void Compressor< SampleType >::computeGain (int               channel,
+                                            const SampleType* sidechain,
+                                            SampleType*       gains,
+                                            int               numSamples) noexcept
+{
+    envelopeFilter.process (channel, sidechain, gains, numSamples);  // Ballistics filter with peak rectifier
+
+    // VCA
+    envelopeToGain (gains, numSamples, thresholdInverse, ratioInverse - SampleType (1.0), true);
+}
+
 
 template < typename SampleType >
 void Compressor< SampleType >::setThreshold (float newThresh_dB)
@@ -5,6 +5,7 @@ namespace bav::dsp::FX
 {
 /*
     Simple compressor that allows you to sidechain the signal.
+    Each block's envelope is detected in one pass, and its gains are computed in the log domain and applied with vecops.
 */
 
 template < typename SampleType >
@@ -21,6 +22,12 @@ public:
                               SampleType  sidechainSample,
                               SampleType* gainReduction);
 
+    /* Writes the compressor's gain for each sample of the sidechain signal. */
+    void computeGain (int               channel,
+                      const SampleType* sidechain,
+                      SampleType*       gains,
+                      int               numSamples) noexcept;
+
     void setThreshold (float newThresh_dB);
     void setRatio (float newRatio);
     void setAttack (float attackMs);
@@ -36,10 +43,10 @@ private:
 
     void update();
 
-    SampleType                                threshold, thresholdInverse, ratioInverse;
-    juce::dsp::BallisticsFilter< SampleType > envelopeFilter;
+    SampleType                     threshold, thresholdInverse, ratioInverse;
+    EnvelopeFollower< SampleType > envelopeFilter;
 
-    juce::dsp::ProcessSpec spec;
+    std::vector< SampleType > gainBuffer;
 
     double     sampleRate  = 44100.0;
     SampleType thresholddB = 0.0, ratio = 1.0, attackTime = 1.0, releaseTime = 100.0;
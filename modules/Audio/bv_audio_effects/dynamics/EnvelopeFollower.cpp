@@ -0,0 +1,125 @@
+
+namespace bav::dsp::FX
+{
+template < typename SampleType >
+void EnvelopeFollower< SampleType >::prepare (double samplerate, int numChannels)
+{
+    jassert (samplerate > 0 && numChannels > 0);
+
+    sampleRate = samplerate;
+    state.resize (static_cast< size_t > (numChannels));
+
+    update();
+    reset();
+}
+
+template < typename SampleType >
+void EnvelopeFollower< SampleType >::reset()
+{
+    std::fill (state.begin(), state.end(), SampleType (0));
+}
+
+template < typename SampleType >
+void EnvelopeFollower< SampleType >::setLevelType (LevelType newType)
+{
+    levelType = newType;
+    reset();
+}
+
+template < typename SampleType >
+void EnvelopeFollower< SampleType >::setAttackTime (SampleType attackMs)
+{
+    attackTime = attackMs;
+    update();
+}
+
+template < typename SampleType >
+void EnvelopeFollower< SampleType >::setReleaseTime (SampleType releaseMs)
+{
+    releaseTime = releaseMs;
+    update();
+}
+
+template < typename SampleType >
+void EnvelopeFollower< SampleType >::update()
+{
+    const auto expFactor = -2.0 * juce::MathConstants< double >::pi * 1000.0 / sampleRate;
+
+    const auto coefficientFor = [expFactor] (SampleType timeMs)
+    {
+        return timeMs < static_cast< SampleType > (1.0e-3) ? SampleType (0)
+                                                            : static_cast< SampleType > (std::exp (expFactor / static_cast< double > (timeMs)));
+    };
+
+    attackCoef  = coefficientFor (attackTime);
+    releaseCoef = coefficientFor (releaseTime);
+}
+
+template < typename SampleType >
+void EnvelopeFollower< SampleType >::process (int channel, const SampleType* input, SampleType* envelope, int numSamples) noexcept
+{
+    jassert (channel >= 0 && channel < static_cast< int > (state.size()));
+
+    const auto attack  = attackCoef;
+    const auto release = releaseCoef;
+
+    auto y = state[static_cast< size_t > (channel)];
+
+    if (levelType == RMSLevel)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto x   = input[i] * input[i];
+            const auto cte = x > y ? attack : release;
+            y              = x + cte * (y - x);
+            envelope[i]    = y;
+        }
+    }
+    else
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto x   = std::abs (input[i]);
+            const auto cte = x > y ? attack : release;
+            y              = x + cte * (y - x);
+            envelope[i]    = y;
+        }
+    }
+
+    juce::dsp::util::snapToZero (y);
+    state[static_cast< size_t > (channel)] = y;
+
+    if (levelType == RMSLevel)
+        vecops::squareRoot (envelope, numSamples);
+}
+
+template class EnvelopeFollower< float >;
+template class EnvelopeFollower< double >;
+
+/*--------------------------------------------------------------------------------------------------------------*/
+
+template < typename SampleType >
+void envelopeToGain (SampleType* envelopeInGainOut,
+                     int         numSamples,
+                     SampleType  thresholdInverse,
+                     SampleType  exponent,
+                     bool        actsAboveThreshold)
+{
+    auto* data = envelopeInGainOut;
+
+    vecops::multiplyC (data, thresholdInverse, numSamples);
+    vecops::fastLog2 (data, numSamples);
+
+    // a log level of 0 is exactly at the threshold, and gives a gain of 1
+    if (actsAboveThreshold)
+        juce::FloatVectorOperations::max (data, data, SampleType (0), numSamples);
+    else
+        juce::FloatVectorOperations::min (data, data, SampleType (0), numSamples);
+
+    vecops::multiplyC (data, exponent, numSamples);
+    vecops::fastExp2 (data, numSamples);
+}
+template void envelopeToGain (float*, int, float, float, bool);
+template void envelopeToGain (double*, int, double, double, bool);
+
+}  // namespace bav::dsp::FX
@@ -0,0 +1,55 @@
+#pragma once
+
+namespace bav::dsp::FX
+{
+/*
+    Level detector with attack and release ballistics, shared by the dynamics processors.
+    It behaves like juce::dsp::BallisticsFilter, but detects a whole block per call in one tight loop.
+*/
+template < typename SampleType >
+class EnvelopeFollower
+{
+public:
+    enum LevelType
+    {
+        PeakLevel,
+        RMSLevel
+    };
+
+    void prepare (double samplerate, int numChannels = 2);
+    void reset();
+
+    void setLevelType (LevelType newType);
+    void setAttackTime (SampleType attackMs);
+    void setReleaseTime (SampleType releaseMs);
+
+    /* The envelope may point to the same memory as the input. */
+    void process (int channel, const SampleType* input, SampleType* envelope, int numSamples) noexcept;
+
+private:
+    void update();
+
+    std::vector< SampleType > state;
+
+    LevelType  levelType {PeakLevel};
+    SampleType attackTime {1}, releaseTime {100};
+    SampleType attackCoef {0}, releaseCoef {0};
+
+    double sampleRate {44100.};
+};
+
+/*--------------------------------------------------------------------------------------------------------------*/
+
+/*
+    Turns a block of envelope values into VCA gains, in place.
+    On the side of the threshold where the processor acts, gain = (envelope / threshold) ^ exponent, and elsewhere the gain is 1.
+    The power is computed in the log domain with the vectorised approximations in vecops.
+*/
+template < typename SampleType >
+void envelopeToGain (SampleType* envelopeInGainOut,
+                     int         numSamples,
+                     SampleType  thresholdInverse,
+                     SampleType  exponent,
+                     bool        actsAboveThreshold);
+
+}  // namespace bav::dsp::FX
@@ -34,6 +34,9 @@ void Limiter< SampleType >::prepare (double samplerate, int blocksize)
     firstStageCompressor.prepare (samplerate, blocksize);
     secondStageCompressor.prepare (samplerate, blocksize);
 
+    firstStageGains.resize (static_cast< size_t > (blocksize));
+    secondStageGains.resize (static_cast< size_t > (blocksize));
+
     update();
     reset();
 }
@@ -55,19 +58,27 @@ SampleType Limiter< SampleType >::processChannel (int               channel,
                                                   SampleType*       signalToLimit,
                                                   const SampleType* sidechain)
 {
-    if (numSamples == 0) return (SampleType) 0;
+    const auto chunkSize = static_cast< int > (firstStageGains.size());
+
+    if (numSamples == 0 || chunkSize == 0) return (SampleType) 0;
 
     const auto levelBefore = getMagnitude (signalToLimit, numSamples);
 
-    for (int s = 0; s < numSamples; ++s)
+    auto* gains       = firstStageGains.data();
+    auto* secondGains = secondStageGains.data();
+
+    // both stages are keyed from the sidechain, so their gains can be computed independently and applied together
+    for (int start = 0; start < numSamples; start += chunkSize)
     {
-        const auto sc = sidechain[s];
+        const auto chunk = std::min (chunkSize, numSamples - start);
 
-        signalToLimit[s] = firstStageCompressor.processSample (channel, signalToLimit[s], sc, nullptr);
+        firstStageCompressor.computeGain (channel, sidechain + start, gains, chunk);
+        secondStageCompressor.computeGain (channel, sidechain + start, secondGains, chunk);
 
-        signalToLimit[s] = secondStageCompressor.processSample (channel, signalToLimit[s], sc, nullptr);
+        vecops::multiplyV (gains, secondGains, chunk);
+        vecops::multiplyV (signalToLimit + start, gains, chunk);
 
-        signalToLimit[s] = signalToLimit[s] * outputVolume.getNextValue();
+        outputVolume.applyGain (signalToLimit + start, chunk);
     }
 
     juce::FloatVectorOperations::clip (signalToLimit,
@@ -28,6 +28,8 @@ private:
 
     Compressor< SampleType > firstStageCompressor, secondStageCompressor;
 
+    std::vector< SampleType > firstStageGains, secondStageGains;
+
     juce::SmoothedValue< SampleType, juce::ValueSmoothingTypes::Linear >
         outputVolume;
 
@@ -4,12 +4,9 @@ namespace bav::dsp::FX
 template < typename SampleType >
 NoiseGate< SampleType >::NoiseGate()
 {
-    spec.numChannels = 2;
-
     update();
 
-    RMSFilter.setLevelCalculationType (
-        juce::dsp::BallisticsFilterLevelCalculationType::RMS);
+    RMSFilter.setLevelType (EnvelopeFollower< SampleType >::RMSLevel);
     RMSFilter.setAttackTime (static_cast< SampleType > (0.0));
     RMSFilter.setReleaseTime (static_cast< SampleType > (50.0));
 }
@@ -59,11 +56,10 @@ void NoiseGate< SampleType >::prepare (double samplerate, int blocksize)
 {
     jassert (samplerate > 0);
 
-    spec.sampleRate       = samplerate;
-    spec.maximumBlockSize = static_cast< juce::uint32 > (blocksize);
+    RMSFilter.prepare (samplerate);
+    envelopeFilter.prepare (samplerate);
 
-    RMSFilter.prepare (spec);
-    envelopeFilter.prepare (spec);
+    gainBuffer.resize (static_cast< size_t > (blocksize));
 
     update();
     reset();
@@ -83,54 +79,30 @@ SampleType NoiseGate< SampleType >::processChannel (int               channel,
                                                     SampleType*       signalToGate,
                                                     const SampleType* sidechain)
 {
-    if (numSamples == 0) return (SampleType) 0;
+    const auto chunkSize = static_cast< int > (gainBuffer.size());
 
-    SampleType avgGainReduction = 0;
-    SampleType gainRedux        = 0;
+    if (numSamples == 0 || chunkSize == 0) return (SampleType) 0;
 
-    for (int s = 0; s < numSamples; ++s)
-    {
-        signalToGate[s] = processSample (channel, signalToGate[s], sidechain[s], &gainRedux);
-        avgGainReduction += gainRedux;
-    }
+    auto* gains = gainBuffer.data();
 
-    return avgGainReduction * ((SampleType) 1 / (SampleType) numSamples);
-}
+    SampleType totalGain = 0;
 
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const auto chunk = std::min (chunkSize, numSamples - start);
 
-template < typename SampleType >
-SampleType NoiseGate< SampleType >::processSample (const int        channel,
-                                                   const SampleType sampleToGate,
-                                                   const SampleType sidechainValue,
-                                                   SampleType*      gainReduction)
-{
-    auto env = RMSFilter.processSample (channel,
-                                        sidechainValue);  // RMS ballistics filter
+        RMSFilter.process (channel, sidechain + start, gains, chunk);  // RMS ballistics filter
+        envelopeFilter.process (channel, gains, gains, chunk);         // Ballistics filter
 
-    env = envelopeFilter.processSample (channel, env);  // Ballistics filter
+        // VCA: an inverted gate acts above the threshold instead of below it
+        envelopeToGain (gains, chunk, thresholdInverse, currentRatio - static_cast< SampleType > (1.0), inverted);
 
-    // VCA
-    SampleType gain;
+        vecops::multiplyV (signalToGate + start, gains, chunk);
 
-    if (inverted)
-    {
-        gain = (env < threshold)
-                 ? static_cast< SampleType > (1.0)
-                 : std::pow (env * thresholdInverse,
-                             currentRatio - static_cast< SampleType > (1.0));
+        totalGain = std::accumulate (gains, gains + chunk, totalGain);
     }
-    else
-    {
-        gain = (env > threshold)
-                 ? static_cast< SampleType > (1.0)
-                 : std::pow (env * thresholdInverse,
-                             currentRatio - static_cast< SampleType > (1.0));
-    }
-
-    if (gainReduction != nullptr)  // report gain reduction, if requested
-        *gainReduction = gain;
 
-    return gain * sampleToGate;
+    return totalGain * ((SampleType) 1 / (SampleType) numSamples);
 }
 
 template < typename SampleType >
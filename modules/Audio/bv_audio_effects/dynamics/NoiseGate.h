@@ -7,6 +7,7 @@ namespace bav::dsp::FX
 {
 /*
         Simple noise gate that allows you to sidechain the signal.
+        Like the Compressor, it detects and applies its gain a block at a time.
     */
 
 template < typename SampleType >
@@ -31,17 +32,12 @@ public:
                                const SampleType* sidechain) final;
 
 private:
-    SampleType processSample (const int        channel,
-                              const SampleType sampleToGate,
-                              const SampleType sidechainValue,
-                              SampleType*      gainReduction);
-
     void update();
 
-    juce::dsp::ProcessSpec spec;
+    SampleType                     threshold, thresholdInverse, currentRatio;
+    EnvelopeFollower< SampleType > envelopeFilter, RMSFilter;
 
-    SampleType                                threshold, thresholdInverse, currentRatio;
-    juce::dsp::BallisticsFilter< SampleType > envelopeFilter, RMSFilter;
+    std::vector< SampleType > gainBuffer;
 
     SampleType thresholddB = -100, ratio = 10.0, attackTime = 1.0,
                releaseTime = 100.0;
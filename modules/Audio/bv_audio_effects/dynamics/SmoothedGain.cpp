@@ -1,18 +1,11 @@
 
 namespace bav::dsp::FX
 {
-template < typename SampleType, size_t channels >
-SmoothedGain< SampleType, channels >::SmoothedGain()
-{
-    for (size_t i = 0; i < channels; ++i)
-        smoothers.add (new ValueSmoother< SampleType >());
-}
-
 template < typename SampleType, size_t channels >
 void SmoothedGain< SampleType, channels >::setGain (float gain)
 {
-    for (auto* smoother : smoothers)
-        smoother->set (gain);
+    for (auto& smoother : smoothers)
+        smoother.set (gain);
 }
 
 template < typename SampleType, size_t channels >
@@ -31,23 +24,22 @@ void SmoothedGain< SampleType, channels >::process (AudioBuffer& audio)
          chan < std::min (static_cast< int > (channels), audio.getNumChannels());
          ++chan)
     {
-        smoothers[chan]->applyGain (audio.getWritePointer (chan), numSamples);
+        smoothers[static_cast< size_t > (chan)].applyGain (audio.getWritePointer (chan), numSamples);
     }
 }
 
 template < typename SampleType, size_t channels >
 void SmoothedGain< SampleType, channels >::reset()
 {
-    for (auto* smoother : smoothers)
-        smoother->reset (lastBlocksize);
+    for (auto& smoother : smoothers)
+        smoother.reset (lastBlocksize);
 }
 
 template < typename SampleType, size_t channels >
 void SmoothedGain< SampleType, channels >::skipSamples (int numSamples)
 {
-    for (auto* smoother : smoothers)
-        for (int s = 0; s < numSamples; ++s)
-            smoother->getNextValue();
+    for (auto& smoother : smoothers)
+        smoother.skip (numSamples);
 }
 
 template class SmoothedGain< float, 1 >;
@@ -9,8 +9,6 @@ class SmoothedGain : public AudioEffect< SampleType >
 public:
     using AudioBuffer = juce::AudioBuffer< SampleType >;
 
-    SmoothedGain();
-
     void prepare (double samplerate, int blocksize) final;
     void process (AudioBuffer& audio) final;
 
@@ -20,7 +18,7 @@ public:
     void skipSamples (int numSamples);
 
 private:
-    juce::OwnedArray< ValueSmoother< SampleType > > smoothers;
+    std::array< ValueSmoother< SampleType >, channels > smoothers;
 
     int lastBlocksize = 0;
 };
@@ -0,0 +1,260 @@
+
+namespace bav::dsp::FX
+{
+// mutually prime delay lengths in samples at 44.1 kHz, spread exponentially
+template < int numLines >
+static constexpr std::array< int, numLines > getLineTunings()
+{
+    if constexpr (numLines == 8)
+        return {809, 929, 1069, 1223, 1399, 1607, 1847, 2111};
+    else
+        return {601, 659, 727, 797, 877, 953, 1049, 1151, 1259, 1381, 1523, 1663, 1823, 1997, 2203, 2399};
+}
+
+// decay is specified per this many samples at 44.1 kHz, so that room size matches Freeverb's comb feedback
+static constexpr double fdnReferenceLength = 1378.;
+
+/* In-place fast Walsh-Hadamard transform: every output is the sum or difference of all the inputs.
+   Each stage is a butterfly between two contiguous halves, so that it maps onto whole SIMD registers. */
+template < size_t size, typename SampleType >
+static inline void hadamard (SampleType* v) noexcept
+{
+    constexpr auto half = size / 2;
+
+    for (size_t j = 0; j < half; ++j)
+    {
+        const auto a = v[j];
+        const auto b = v[j + half];
+
+        v[j]        = a + b;
+        v[j + half] = a - b;
+    }
+
+    if constexpr (half > 1)
+    {
+        hadamard< half > (v);
+        hadamard< half > (v + half);
+    }
+}
+
+template < typename SampleType, int numLines >
+void FeedbackDelayNetwork< SampleType, numLines >::prepare (double samplerate)
+{
+    jassert (samplerate > 0.);
+
+    constexpr auto tunings = getLineTunings< numLines >();
+
+    size_t longest = 0;
+
+    for (size_t l = 0; l < lengths.size(); ++l)
+    {
+        lengths[l]        = static_cast< size_t > (std::max (1, static_cast< int > (tunings[l] * samplerate / 44100.)));
+        decayExponents[l] = static_cast< SampleType > (tunings[l] / fdnReferenceLength);
+        longest           = std::max (longest, lengths[l]);
+    }
+
+    // a power-of-two length lets the read and write positions wrap with a mask
+    size_t size = 1;
+
+    while (size <= longest)
+        size *= 2;
+
+    mask = size - 1;
+    lines.resize (size * static_cast< size_t > (numLines));
+
+    constexpr auto smoothTime = 0.01;
+
+    for (auto* smoother : {&damping, &feedback, &dryGain, &wetGain1, &wetGain2})
+        smoother->reset (samplerate, smoothTime);
+
+    reset();
+    setParameters (parameters);
+}
+
+template < typename SampleType, int numLines >
+void FeedbackDelayNetwork< SampleType, numLines >::reset()
+{
+    std::fill (lines.begin(), lines.end(), SampleType (0));
+    lowpassState.fill (SampleType (0));
+    writeIndex = 0;
+}
+
+template < typename SampleType, int numLines >
+void FeedbackDelayNetwork< SampleType, numLines >::setParameters (const Parameters& newParams)
+{
+    constexpr auto wetScaleFactor = 3.0f;
+    constexpr auto dryScaleFactor = 2.0f;
+
+    const auto wet = newParams.wetLevel * wetScaleFactor;
+
+    dryGain.setTargetValue (static_cast< SampleType > (newParams.dryLevel * dryScaleFactor));
+    wetGain1.setTargetValue (static_cast< SampleType > (0.5f * wet * (1.0f + newParams.width)));
+    wetGain2.setTargetValue (static_cast< SampleType > (0.5f * wet * (1.0f - newParams.width)));
+
+    const auto frozen = newParams.freezeMode >= 0.5f;
+
+    gain       = frozen ? SampleType (0) : static_cast< SampleType > (0.25 * std::sqrt (8. / numLines));
+    parameters = newParams;
+
+    // the left channel feeds and taps the even lines, and the right channel the odd ones.
+    // The input and output sign patterns differ, which decorrelates the two outputs.
+    for (size_t l = 0; l < static_cast< size_t > (numLines); ++l)
+    {
+        const auto inSign  = (l / 2) % 2 == 0 ? SampleType (1) : SampleType (-1);
+        const auto outSign = l < static_cast< size_t > (numLines / 2) ? SampleType (1) : SampleType (-1);
+        const auto isLeft  = l % 2 == 0;
+
+        inputGainsL[l] = isLeft ? gain * inSign : SampleType (0);
+        inputGainsR[l] = isLeft ? SampleType (0) : gain * inSign;
+        outputTapsL[l] = isLeft ? outSign : SampleType (0);
+        outputTapsR[l] = isLeft ? SampleType (0) : outSign;
+    }
+
+    updateDamping();
+}
+
+template < typename SampleType, int numLines >
+void FeedbackDelayNetwork< SampleType, numLines >::updateDamping()
+{
+    constexpr auto roomScaleFactor = 0.28f;
+    constexpr auto roomOffset      = 0.7f;
+    constexpr auto dampScaleFactor = 0.4f;
+
+    if (parameters.freezeMode >= 0.5f)
+    {
+        damping.setTargetValue (SampleType (0));
+        feedback.setTargetValue (SampleType (1));
+    }
+    else
+    {
+        damping.setTargetValue (static_cast< SampleType > (parameters.damping * dampScaleFactor));
+        feedback.setTargetValue (static_cast< SampleType > (parameters.roomSize * roomScaleFactor + roomOffset));
+    }
+}
+
+template < typename SampleType, int numLines >
+void FeedbackDelayNetwork< SampleType, numLines >::updateDecayGains (SampleType feedbackLevel) noexcept
+{
+    if (feedbackLevel == currentFeedback) return;
+
+    currentFeedback = feedbackLevel;
+
+    // the Hadamard matrix's normalisation is folded into the per-line decay
+    const auto normalise = static_cast< SampleType > (1. / std::sqrt (static_cast< double > (numLines)));
+
+    for (size_t l = 0; l < decayGains.size(); ++l)
+        decayGains[l] = std::pow (feedbackLevel, decayExponents[l]) * normalise;
+}
+
+template < typename SampleType, int numLines >
+void FeedbackDelayNetwork< SampleType, numLines >::processMono (SampleType* samples, int numSamples) noexcept
+{
+    processInternal< false > (samples, samples, numSamples);
+}
+
+template < typename SampleType, int numLines >
+void FeedbackDelayNetwork< SampleType, numLines >::processStereo (SampleType* left, SampleType* right, int numSamples) noexcept
+{
+    processInternal< true > (left, right, numSamples);
+}
+
+template < typename SampleType, int numLines >
+template < bool isStereo >
+void FeedbackDelayNetwork< SampleType, numLines >::processInternal (SampleType* left, SampleType* right, int numSamples) noexcept
+{
+    // the smoothed parameters are updated once per chunk; the decay gains cost a pow() per line to recalculate
+    constexpr int chunkSize = 32;
+
+    const auto denormalThreshold = static_cast< SampleType > (1.0e-15);
+    const auto stride            = static_cast< size_t > (numLines);
+
+    // local copies, which the compiler can keep in registers while the delay buffer is written
+    const auto gainsL = inputGainsL, gainsR = inputGainsR;
+    const auto tapsL = outputTapsL, tapsR = outputTapsR;
+
+    auto  state = lowpassState;
+    auto  index = writeIndex;
+    auto* data  = lines.data();
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const auto numThisChunk = std::min (chunkSize, numSamples - start);
+        const auto invChunk     = SampleType (1) / static_cast< SampleType > (numThisChunk);
+
+        const auto damp = damping.skip (numThisChunk);
+        updateDecayGains (feedback.skip (numThisChunk));
+        const auto decay = decayGains;
+
+        // the output gains ramp linearly across the chunk
+        auto       dry      = dryGain.getCurrentValue();
+        auto       wet1     = wetGain1.getCurrentValue();
+        auto       wet2     = wetGain2.getCurrentValue();
+        const auto dryStep  = (dryGain.skip (numThisChunk) - dry) * invChunk;
+        const auto wet1Step = (wetGain1.skip (numThisChunk) - wet1) * invChunk;
+        const auto wet2Step = (wetGain2.skip (numThisChunk) - wet2) * invChunk;
+
+        for (int i = start; i < start + numThisChunk; ++i)
+        {
+            const auto inL = left[i];
+            const auto inR = isStereo ? right[i] : inL;
+
+            Frame v;
+
+            for (size_t l = 0; l < stride; ++l)
+                v[l] = data[((index - lengths[l]) & mask) * stride + l];
+
+            for (size_t l = 0; l < stride; ++l)
+            {
+                state[l] = v[l] + damp * (state[l] - v[l]);
+                v[l]     = state[l];
+            }
+
+            auto outL = SampleType (0), outR = SampleType (0);
+
+            for (size_t l = 0; l < stride; ++l)
+            {
+                outL += v[l] * tapsL[l];
+                outR += v[l] * tapsR[l];
+            }
+
+            hadamard< numLines > (v.data());
+
+            auto* frame = data + index * stride;
+
+            for (size_t l = 0; l < stride; ++l)
+            {
+                const auto x = v[l] * decay[l] + inL * gainsL[l] + inR * gainsR[l];
+                frame[l]     = std::abs (x) < denormalThreshold ? SampleType (0) : x;
+            }
+
+            index = (index + 1) & mask;
+
+            dry += dryStep;
+            wet1 += wet1Step;
+            wet2 += wet2Step;
+
+            if constexpr (isStereo)
+            {
+                left[i]  = outL * wet1 + outR * wet2 + inL * dry;
+                right[i] = outR * wet1 + outL * wet2 + inR * dry;
+            }
+            else
+            {
+                left[i] = (outL + outR) * wet1 + inL * dry;
+            }
+        }
+    }
+
+    for (auto& s : state)
+        juce::dsp::util::snapToZero (s);
+
+    lowpassState = state;
+    writeIndex   = index;
+}
+
+template class FeedbackDelayNetwork< float, 8 >;
+template class FeedbackDelayNetwork< double, 8 >;
+template class FeedbackDelayNetwork< float, 16 >;
+template class FeedbackDelayNetwork< double, 16 >;
+
+}  // namespace bav::dsp::FX
@@ -0,0 +1,50 @@
+#pragma once
+
+namespace bav::dsp::FX
+{
+/*
+    A feedback delay network reverb: numLines damped delay lines, mixed back into each other through a Hadamard matrix.
+    All the lines live in one interleaved buffer, one frame of numLines samples per time step, so every step is a handful of lane-wise operations instead of a chain of serial filters.
+    It takes the same parameters as Freeverb, and can be used in its place.
+*/
+template < typename SampleType, int numLines = 8 >
+class FeedbackDelayNetwork
+{
+    static_assert (numLines == 8 || numLines == 16, "The Hadamard mixing matrix needs 8 or 16 lines");
+
+public:
+    using Parameters = juce::Reverb::Parameters;
+
+    /* Allocates the delay lines, so call this from the message thread. */
+    void prepare (double samplerate);
+    void reset();
+
+    void              setParameters (const Parameters& newParams);
+    const Parameters& getParameters() const { return parameters; }
+
+    void processMono (SampleType* samples, int numSamples) noexcept;
+    void processStereo (SampleType* left, SampleType* right, int numSamples) noexcept;
+
+private:
+    using Frame = std::array< SampleType, numLines >;
+
+    template < bool isStereo >
+    void processInternal (SampleType* left, SampleType* right, int numSamples) noexcept;
+
+    void updateDecayGains (SampleType feedbackLevel) noexcept;
+    void updateDamping();
+
+    std::vector< SampleType > lines;
+    size_t                    mask {0}, writeIndex {0};
+
+    std::array< size_t, numLines > lengths {};
+    Frame                          decayExponents {}, decayGains {}, lowpassState {};
+    Frame                          inputGainsL {}, inputGainsR {}, outputTapsL {}, outputTapsR {};
+
+    Parameters parameters;
+    SampleType gain {0}, currentFeedback {-1};
+
+    juce::SmoothedValue< SampleType > damping, feedback, dryGain, wetGain1, wetGain2;
+};
+
+}  // namespace bav::dsp::FX
@@ -0,0 +1,218 @@
+
+namespace bav::dsp::FX
+{
+template < typename SampleType >
+void Freeverb< SampleType >::CombFilter::setSize (int size)
+{
+    jassert (size > 0);
+    buffer.resize (static_cast< size_t > (size));
+    clear();
+}
+
+template < typename SampleType >
+void Freeverb< SampleType >::CombFilter::clear()
+{
+    std::fill (buffer.begin(), buffer.end(), SampleType (0));
+    index = 0;
+    last  = SampleType (0);
+}
+
+template < typename SampleType >
+SampleType Freeverb< SampleType >::CombFilter::process (SampleType input, SampleType damp, SampleType feedbackLevel) noexcept
+{
+    const auto output = buffer[static_cast< size_t > (index)];
+
+    last = (output * (SampleType (1) - damp)) + (last * damp);
+    juce::dsp::util::snapToZero (last);
+
+    auto temp = input + (last * feedbackLevel);
+    juce::dsp::util::snapToZero (temp);
+
+    buffer[static_cast< size_t > (index)] = temp;
+
+    if (++index == static_cast< int > (buffer.size()))
+        index = 0;
+
+    return output;
+}
+
+template < typename SampleType >
+void Freeverb< SampleType >::AllPassFilter::setSize (int size)
+{
+    jassert (size > 0);
+    buffer.resize (static_cast< size_t > (size));
+    clear();
+}
+
+template < typename SampleType >
+void Freeverb< SampleType >::AllPassFilter::clear()
+{
+    std::fill (buffer.begin(), buffer.end(), SampleType (0));
+    index = 0;
+}
+
+template < typename SampleType >
+SampleType Freeverb< SampleType >::AllPassFilter::process (SampleType input) noexcept
+{
+    const auto bufferedValue = buffer[static_cast< size_t > (index)];
+
+    auto temp = input + (bufferedValue * SampleType (0.5));
+    juce::dsp::util::snapToZero (temp);
+
+    buffer[static_cast< size_t > (index)] = temp;
+
+    if (++index == static_cast< int > (buffer.size()))
+        index = 0;
+
+    return bufferedValue - input;
+}
+
+/*--------------------------------------------------------------------------------------------------------------*/
+
+template < typename SampleType >
+void Freeverb< SampleType >::prepare (double samplerate)
+{
+    jassert (samplerate > 0.);
+
+    // delay lengths in samples at 44.1 kHz
+    static constexpr int combTunings[numCombs]        = {1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617};
+    static constexpr int allPassTunings[numAllPasses] = {556, 441, 341, 225};
+    static constexpr int stereoSpread                 = 23;
+
+    const auto scaled = [samplerate] (int tuning)
+    { return std::max (1, static_cast< int > (static_cast< double > (tuning) * samplerate / 44100.)); };
+
+    for (int i = 0; i < numCombs; ++i)
+    {
+        comb[0][i].setSize (scaled (combTunings[i]));
+        comb[1][i].setSize (scaled (combTunings[i] + stereoSpread));
+    }
+
+    for (int i = 0; i < numAllPasses; ++i)
+    {
+        allPass[0][i].setSize (scaled (allPassTunings[i]));
+        allPass[1][i].setSize (scaled (allPassTunings[i] + stereoSpread));
+    }
+
+    constexpr auto smoothTime = 0.01;
+
+    for (auto* smoother : {&damping, &feedback, &dryGain, &wetGain1, &wetGain2})
+        smoother->reset (samplerate, smoothTime);
+
+    setParameters (parameters);
+}
+
+template < typename SampleType >
+void Freeverb< SampleType >::reset()
+{
+    for (int c = 0; c < numChannels; ++c)
+    {
+        for (auto& filter : comb[c])
+            filter.clear();
+
+        for (auto& filter : allPass[c])
+            filter.clear();
+    }
+}
+
+template < typename SampleType >
+void Freeverb< SampleType >::setParameters (const Parameters& newParams)
+{
+    constexpr auto wetScaleFactor = 3.0f;
+    constexpr auto dryScaleFactor = 2.0f;
+
+    const auto wet = newParams.wetLevel * wetScaleFactor;
+
+    dryGain.setTargetValue (static_cast< SampleType > (newParams.dryLevel * dryScaleFactor));
+    wetGain1.setTargetValue (static_cast< SampleType > (0.5f * wet * (1.0f + newParams.width)));
+    wetGain2.setTargetValue (static_cast< SampleType > (0.5f * wet * (1.0f - newParams.width)));
+
+    const auto frozen = newParams.freezeMode >= 0.5f;
+
+    gain       = frozen ? SampleType (0) : static_cast< SampleType > (0.015);
+    parameters = newParams;
+
+    updateDamping();
+}
+
+template < typename SampleType >
+void Freeverb< SampleType >::updateDamping()
+{
+    constexpr auto roomScaleFactor = 0.28f;
+    constexpr auto roomOffset      = 0.7f;
+    constexpr auto dampScaleFactor = 0.4f;
+
+    if (parameters.freezeMode >= 0.5f)
+    {
+        damping.setTargetValue (SampleType (0));
+        feedback.setTargetValue (SampleType (1));
+    }
+    else
+    {
+        damping.setTargetValue (static_cast< SampleType > (parameters.damping * dampScaleFactor));
+        feedback.setTargetValue (static_cast< SampleType > (parameters.roomSize * roomScaleFactor + roomOffset));
+    }
+}
+
+template < typename SampleType >
+void Freeverb< SampleType >::processMono (SampleType* samples, int numSamples) noexcept
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto input = samples[i] * gain;
+        const auto damp  = damping.getNextValue();
+        const auto fb    = feedback.getNextValue();
+
+        auto output = SampleType (0);
+
+        for (auto& filter : comb[0])  // the combs run in parallel
+            output += filter.process (input, damp, fb);
+
+        for (auto& filter : allPass[0])  // and the allpasses in series
+            output = filter.process (output);
+
+        const auto dry  = dryGain.getNextValue();
+        const auto wet1 = wetGain1.getNextValue();
+
+        wetGain2.getNextValue();
+
+        samples[i] = output * wet1 + samples[i] * dry;
+    }
+}
+
+template < typename SampleType >
+void Freeverb< SampleType >::processStereo (SampleType* left, SampleType* right, int numSamples) noexcept
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto input = (left[i] + right[i]) * gain;
+        const auto damp  = damping.getNextValue();
+        const auto fb    = feedback.getNextValue();
+
+        auto outL = SampleType (0), outR = SampleType (0);
+
+        for (int j = 0; j < numCombs; ++j)
+        {
+            outL += comb[0][j].process (input, damp, fb);
+            outR += comb[1][j].process (input, damp, fb);
+        }
+
+        for (int j = 0; j < numAllPasses; ++j)
+        {
+            outL = allPass[0][j].process (outL);
+            outR = allPass[1][j].process (outR);
+        }
+
+        const auto dry  = dryGain.getNextValue();
+        const auto wet1 = wetGain1.getNextValue();
+        const auto wet2 = wetGain2.getNextValue();
+
+        left[i]  = outL * wet1 + outR * wet2 + left[i] * dry;
+        right[i] = outR * wet1 + outL * wet2 + right[i] * dry;
+    }
+}
+
+template class Freeverb< float >;
+template class Freeverb< double >;
+
+}  // namespace bav::dsp::FX
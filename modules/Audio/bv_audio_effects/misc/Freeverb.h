@@ -0,0 +1,60 @@
+#pragma once
+
+namespace bav::dsp::FX
+{
+/*
+    The Freeverb algorithm, templated on sample type: eight parallel damped comb filters feeding four series allpasses per channel.
+    It behaves like juce::Reverb and uses the same parameters, so double-precision audio can be processed without converting it to float.
+*/
+template < typename SampleType >
+class Freeverb
+{
+public:
+    using Parameters = juce::Reverb::Parameters;
+
+    /* Allocates the delay lines, so call this from the message thread. */
+    void prepare (double samplerate);
+    void reset();
+
+    void              setParameters (const Parameters& newParams);
+    const Parameters& getParameters() const { return parameters; }
+
+    void processMono (SampleType* samples, int numSamples) noexcept;
+    void processStereo (SampleType* left, SampleType* right, int numSamples) noexcept;
+
+private:
+    struct CombFilter
+    {
+        void       setSize (int size);
+        void       clear();
+        SampleType process (SampleType input, SampleType damp, SampleType feedbackLevel) noexcept;
+
+        std::vector< SampleType > buffer;
+        int                       index {0};
+        SampleType                last {0};
+    };
+
+    struct AllPassFilter
+    {
+        void       setSize (int size);
+        void       clear();
+        SampleType process (SampleType input) noexcept;
+
+        std::vector< SampleType > buffer;
+        int                       index {0};
+    };
+
+    void updateDamping();
+
+    static constexpr int numCombs = 8, numAllPasses = 4, numChannels = 2;
+
+    CombFilter    comb[numChannels][numCombs];
+    AllPassFilter allPass[numChannels][numAllPasses];
+
+    Parameters parameters;
+    SampleType gain {0};
+
+    juce::SmoothedValue< SampleType > damping, feedback, dryGain, wetGain1, wetGain2;
+};
+
+}  // namespace bav::dsp::FX
@@ -1,7 +1,8 @@
 
 namespace bav::dsp::FX
 {
-Reverb::Reverb()
+template < typename SampleType, typename Algorithm >
+Reverb< SampleType, Algorithm >::Reverb()
 {
     params.roomSize   = 0.5f;
     params.damping    = 0.35f;
@@ -14,72 +15,77 @@ Reverb::Reverb()
     compressor.setRelease (35.0f);
 }
 
-void Reverb::prepare (int blocksize, double samplerate, int numChannels)
+template < typename SampleType, typename Algorithm >
+void Reverb< SampleType, Algorithm >::prepare (int blocksize, double samplerate, int numChannels)
 {
     jassert (numChannels <= 2);
     jassert (samplerate > 0 && blocksize > 0 && numChannels > 0);
 
-    reverb.setSampleRate (samplerate);
+    reverb.prepare (samplerate);
     reverb.setParameters (params);
 
     compressor.prepare (samplerate, blocksize);
 
     sampleRate = samplerate;
 
-    loCut.coefs.makeLowPass (
-        samplerate, loCutFreq);
+    loCut.coefs.makeHighPass (
+        samplerate, static_cast< SampleType > (loCutFreq));
     loCut.prepare();
 
-    hiCut.coefs.makeHighPass (
-        samplerate, hiCutFreq);
+    hiCut.coefs.makeLowPass (
+        samplerate, static_cast< SampleType > (hiCutFreq));
     hiCut.prepare();
 
-    sidechainBuffer.setSize (numChannels, blocksize, true, true, true);
     workingBuffer.setSize (numChannels, blocksize, true, true, true);
-    conversionBuffer.setSize (numChannels, blocksize, true, true, true);
+    dryBuffer.setSize (numChannels, blocksize, true, true, true);
 
     dryGain.prepare (samplerate, blocksize);
     wetGain.prepare (samplerate, blocksize);
 }
 
-void Reverb::reset()
+template < typename SampleType, typename Algorithm >
+void Reverb< SampleType, Algorithm >::reset()
 {
     reverb.reset();
     compressor.reset();
     workingBuffer.clear();
-    sidechainBuffer.clear();
-    conversionBuffer.clear();
+    dryBuffer.clear();
 
     dryGain.reset();
     wetGain.reset();
 }
 
-void Reverb::setRoomSize (float newRoomSize)
+template < typename SampleType, typename Algorithm >
+void Reverb< SampleType, Algorithm >::setRoomSize (float newRoomSize)
 {
     params.roomSize = newRoomSize;
     reverb.setParameters (params);
 }
 
-void Reverb::setDamping (float newDampingAmount)
+template < typename SampleType, typename Algorithm >
+void Reverb< SampleType, Algorithm >::setDamping (float newDampingAmount)
 {
     params.damping = newDampingAmount;
     reverb.setParameters (params);
 }
 
-void Reverb::setWidth (float newWidth)
+template < typename SampleType, typename Algorithm >
+void Reverb< SampleType, Algorithm >::setWidth (float newWidth)
 {
     params.width = newWidth;
     reverb.setParameters (params);
 }
 
-void Reverb::setDryWet (int wetMixPercent)
+template < typename SampleType, typename Algorithm >
+void Reverb< SampleType, Algorithm >::setDryWet (int wetMixPercent)
 {
     const auto wet = static_cast< float > (wetMixPercent) * 0.01f;
     wetGain.setGain (wet);
     dryGain.setGain (1.0f - wet);
 }
 
-void Reverb::setDuckAmount (int newDuckAmount)
+template < typename SampleType, typename Algorithm >
+void Reverb< SampleType, Algorithm >::setDuckAmount (int newDuckAmount)
 {
     isDucking = newDuckAmount > 50;
 
@@ -88,102 +94,109 @@ void Reverb::setDuckAmount (int newDuckAmount)
     compressor.setRatio (juce::jmap (duck, 1.0f, 10.0f));
 }
 
-void Reverb::setLoCutFrequency (float freq)
+template < typename SampleType, typename Algorithm >
+void Reverb< SampleType, Algorithm >::setLoCutFrequency (float freq)
 {
     loCutFreq = freq;
-    loCut.coefs.makeLowPass (
-        sampleRate, loCutFreq);
+    loCut.coefs.makeHighPass (
+        sampleRate, static_cast< SampleType > (loCutFreq));
     loCut.reset();
 }
 
-void Reverb::setHiCutFrequency (float freq)
+template < typename SampleType, typename Algorithm >
+void Reverb< SampleType, Algorithm >::setHiCutFrequency (float freq)
 {
     hiCutFreq = freq;
-    hiCut.coefs.makeHighPass (
-        sampleRate, hiCutFreq);
+    hiCut.coefs.makeLowPass (
+        sampleRate, static_cast< SampleType > (hiCutFreq));
     hiCut.reset();
 }
 
 
-void Reverb::process (juce::AudioBuffer< double >& input, double* reverbLevel)
-{
-    process (input, input, reverbLevel);
-}
-
-void Reverb::process (juce::AudioBuffer< float >& input, float* reverbLevel)
+template < typename SampleType, typename Algorithm >
+void Reverb< SampleType, Algorithm >::process (AudioBuffer& input, SampleType* reverbLevel)
 {
     process (input, input, reverbLevel);
 }
 
 
-void Reverb::process (juce::AudioBuffer< double >& input,
-                      juce::AudioBuffer< double >& compressorSidechain,
-                      double*                      reverbLevel)
-{
-    conversionBuffer.makeCopyOf (input, true);
-    sidechainBuffer.makeCopyOf (compressorSidechain, true);
-
-    float level;
-
-    process (conversionBuffer, sidechainBuffer, &level);
-
-    input.makeCopyOf (conversionBuffer, true);
-
-    if (reverbLevel != nullptr) *reverbLevel = static_cast< double > (level);
-}
-
-
-void Reverb::process (juce::AudioBuffer< float >& input,
-                      juce::AudioBuffer< float >& compressorSidechain,
-                      float*                      reverbLevel)
+template < typename SampleType, typename Algorithm >
+void Reverb< SampleType, Algorithm >::process (AudioBuffer&       input,
+                                               const AudioBuffer& compressorSidechain,
+                                               SampleType*        reverbLevel)
 {
     const auto numSamples  = input.getNumSamples();
-    const auto numChannels = std::min (2, input.getNumChannels());
+    const auto numChannels = std::min ({2, workingBuffer.getNumChannels(), input.getNumChannels()});
 
     jassert (numSamples == compressorSidechain.getNumSamples());
-    jassert (numChannels == compressorSidechain.getNumChannels());
+    jassert (compressorSidechain.getNumChannels() > 0);
+    jassert (numSamples <= workingBuffer.getNumSamples());
 
-    dsp::buffers::copy (compressorSidechain, sidechainBuffer);
-    dsp::buffers::copy (input, workingBuffer);
-
-    // reverb
-    switch (numChannels)
-    {
-        case (0) : return;
+    if (numChannels == 0) return;
 
-        case (1) :
-            reverb.processMono (workingBuffer.getWritePointer (0), numSamples);
+    // views of the working buffers, the size of this block
+    AudioBuffer wet {workingBuffer.getArrayOfWritePointers(), numChannels, numSamples};
+    AudioBuffer dry {dryBuffer.getArrayOfWritePointers(), numChannels, numSamples};
 
-        default :
-            reverb.processStereo (workingBuffer.getWritePointer (0),
-                                  workingBuffer.getWritePointer (1),
-                                  numSamples);
+    for (int chan = 0; chan < numChannels; ++chan)
+    {
+        vecops::copy (input.getReadPointer (chan), wet.getWritePointer (chan), numSamples);
+        vecops::copy (input.getReadPointer (chan), dry.getWritePointer (chan), numSamples);
     }
 
+    // reverb
+    if (numChannels == 1)
+        reverb.processMono (wet.getWritePointer (0), numSamples);
+    else
+        reverb.processStereo (wet.getWritePointer (0), wet.getWritePointer (1), numSamples);
+
     if (reverbLevel != nullptr)
-        *reverbLevel = workingBuffer.getMagnitude (0, numSamples);
+        *reverbLevel = wet.getMagnitude (0, numSamples);
 
     // filters
-    loCut.process (workingBuffer);
-    hiCut.process (workingBuffer);
+    loCut.process (wet);
+    hiCut.process (wet);
 
-    // sidechain compressor
-    if (isDucking) compressor.process (sidechainBuffer, workingBuffer);
+    // sidechain compressor: the dry signal ducks the reverb
+    if (isDucking)
+        duck (wet, compressorSidechain);
 
-    input.clear();
-
-    dryGain.process (sidechainBuffer);
-    wetGain.process (workingBuffer);
+    dryGain.process (dry);
+    wetGain.process (wet);
 
     for (int chan = 0; chan < numChannels; ++chan)
     {
-        // add & write result to workingBuffer
-        vecops::addV (workingBuffer.getWritePointer (chan),
-                      sidechainBuffer.getReadPointer (chan),
-                      numSamples);
+        auto* out = input.getWritePointer (chan);
 
-        dsp::buffers::copy (workingBuffer, input);
+        vecops::copy (wet.getReadPointer (chan), out, numSamples);
+        vecops::addV (out, dry.getReadPointer (chan), numSamples);
     }
 }
 
+/* Channels past the sidechain's last one are ducked by its last channel, so a mono sidechain ducks a stereo reverb. */
+template < typename SampleType, typename Algorithm >
+void Reverb< SampleType, Algorithm >::duck (AudioBuffer& wet, const AudioBuffer& sidechain)
+{
+    const auto numSamples           = wet.getNumSamples();
+    const auto numSidechainChannels = sidechain.getNumChannels();
+
+    if (numSidechainChannels == 0 || sidechain.getNumSamples() < numSamples) return;
+
+    std::array< SampleType*, 2 > sidechainChannels {};
+
+    for (int chan = 0; chan < wet.getNumChannels(); ++chan)
+        sidechainChannels[static_cast< size_t > (chan)] = const_cast< SampleType* > (sidechain.getReadPointer (std::min (chan, numSidechainChannels - 1)));
+
+    const AudioBuffer mappedSidechain {sidechainChannels.data(), wet.getNumChannels(), numSamples};
+
+    compressor.process (wet, mappedSidechain);
+}
+
+template class Reverb< float >;
+template class Reverb< double >;
+template class Reverb< float, FeedbackDelayNetwork< float, 8 > >;
+template class Reverb< double, FeedbackDelayNetwork< double, 8 > >;
+template class Reverb< float, FeedbackDelayNetwork< float, 16 > >;
+template class Reverb< double, FeedbackDelayNetwork< double, 16 > >;
+
 }  // namespace bav::dsp::FX
@@ -1,15 +1,19 @@
-
 #pragma once
 
 namespace bav::dsp::FX
 {
 /*
-        Class that wraps juce::Reverb into a usable interface, and includes some other functionality as well: hi- and lo-pass filters, and a sidechain-able compressor.
+        Freeverb with a usable interface, and some other functionality as well: hi- and lo-cut filters, and a sidechain-able compressor.
+        Everything runs at SampleType precision, in working buffers allocated by prepare().
+        The reverb algorithm can be swapped for any class with Freeverb's interface, such as the cheaper FeedbackDelayNetwork.
     */
 
+template < typename SampleType, typename Algorithm = Freeverb< SampleType > >
 class Reverb
 {
 public:
+    using AudioBuffer = juce::AudioBuffer< SampleType >;
+
     Reverb();
     virtual ~Reverb() = default;
 
@@ -25,36 +29,37 @@ public:
     void setHiCutFrequency (float freq);
 
     //  process input with no external compressor sidechain
-    void process (juce::AudioBuffer< double >& input, double* reverbLevel = nullptr);
-    void process (juce::AudioBuffer< float >& input, float* reverbLevel = nullptr);
+    void process (AudioBuffer& input, SampleType* reverbLevel = nullptr);
 
     //  process input with an external signal as the compressor's sidechain
-    void process (juce::AudioBuffer< double >& input,
-                  juce::AudioBuffer< double >& compressorSidechain,
-                  double*                      reverbLevel = nullptr);
-
-    void process (juce::AudioBuffer< float >& input,
-                  juce::AudioBuffer< float >& compressorSidechain,
-                  float*                      reverbLevel = nullptr);
+    void process (AudioBuffer&       input,
+                  const AudioBuffer& compressorSidechain,
+                  SampleType*        reverbLevel = nullptr);
 
 private:
-    juce::Reverb reverb;
+    void duck (AudioBuffer& wet, const AudioBuffer& sidechain);
+
+    Algorithm reverb;
 
     juce::Reverb::Parameters params;
 
-    juce::AudioBuffer< float > conversionBuffer;
-    juce::AudioBuffer< float > workingBuffer;
-    juce::AudioBuffer< float > sidechainBuffer;
+    AudioBuffer workingBuffer;
+    AudioBuffer dryBuffer;
 
-    bool                isDucking;
-    Compressor< float > compressor;
+    bool                     isDucking {false};
+    Compressor< SampleType > compressor;
 
-    dsp::filters::MultiFilter< float > loCut, hiCut;
-    float                              loCutFreq = 80.0f, hiCutFreq = 5500.0f;
+    dsp::filters::MultiFilter< SampleType > loCut, hiCut;
+    float                                   loCutFreq = 80.0f, hiCutFreq = 5500.0f;
 
     double sampleRate = 0.0;
 
-    SmoothedGain< float, 2 > dryGain, wetGain;
+    SmoothedGain< SampleType, 2 > dryGain, wetGain;
 };
 
+
+/* A Reverb running an 8-line feedback delay network: light enough to put on every voice bus. */
+template < typename SampleType >
+using FDNReverb = Reverb< SampleType, FeedbackDelayNetwork< SampleType > >;
+
 }  // namespace bav::dsp::FX
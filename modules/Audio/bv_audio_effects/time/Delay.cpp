@@ -1,9 +1,16 @@
 namespace bav::dsp::FX
 {
+template < typename SampleType >
+void Delay< SampleType >::setMaxDelay (int maxDelayInSamples)
+{
+    jassert (maxDelayInSamples >= 0);
+    maxDelay = maxDelayInSamples;
+}
+
 template < typename SampleType >
 void Delay< SampleType >::setDelay (int delayInSamples)
 {
-    delay.setDelay (SampleType (delayInSamples));
+    delay.setDelay (static_cast< SampleType > (delayInSamples));
 }
 
 template < typename SampleType >
@@ -11,36 +18,49 @@ void Delay< SampleType >::prepare (double samplerate, int blocksize)
 {
     jassert (samplerate > 0);
 
-    spec.sampleRate       = samplerate;
-    spec.maximumBlockSize = static_cast< juce::uint32 > (blocksize);
-    spec.numChannels      = 2;
+    delay.prepare (samplerate, blocksize, numChannels, maxDelay);
 
-    delay.prepare (spec);
+    wetBuffer.setSize (1, blocksize);
 
-    dryGain.reset (blocksize);
-    wetGain.reset (blocksize);
+    for (int chan = 0; chan < numChannels; ++chan)
+    {
+        dryGain[chan].reset (blocksize);
+        wetGain[chan].reset (blocksize);
+    }
 }
 
 template < typename SampleType >
 void Delay< SampleType >::reset()
 {
     delay.reset();
-    dryGain.reset (static_cast< int > (spec.maximumBlockSize));
-    wetGain.reset (static_cast< int > (spec.maximumBlockSize));
+
+    const auto blocksize = wetBuffer.getNumSamples();
+
+    for (int chan = 0; chan < numChannels; ++chan)
+    {
+        dryGain[chan].reset (blocksize);
+        wetGain[chan].reset (blocksize);
+        lastInput[chan] = SampleType (0);
+    }
 }
 
 template < typename SampleType >
 void Delay< SampleType >::setDryWet (int wetMixPercent)
 {
     const auto wet = static_cast< float > (wetMixPercent) * 0.01f;
-    wetGain.set (wet);
-    dryGain.set (1.0f - wet);
+
+    for (int chan = 0; chan < numChannels; ++chan)
+    {
+        wetGain[chan].set (wet);
+        dryGain[chan].set (1.0f - wet);
+    }
 }
 
 
 template < typename SampleType >
 void Delay< SampleType >::pushSample (int channel, SampleType sample)
 {
+    lastInput[channel] = sample;
     delay.pushSample (channel, sample);
 }
 
@@ -48,12 +68,8 @@ void Delay< SampleType >::pushSample (int channel, SampleType sample)
 template < typename SampleType >
 SampleType Delay< SampleType >::popSample (int channel, SampleType* delayLevel)
 {
-    const auto delaySamps = delay.getDelay();
-
-    const auto drySample = delay.popSample (channel, SampleType (0), false)
-                         * dryGain.getNextValue();
-    const auto wetSample =
-        delay.popSample (channel, delaySamps, true) * wetGain.getNextValue();
+    const auto drySample = lastInput[channel] * dryGain[channel].getNextValue();
+    const auto wetSample = delay.popSample (channel) * wetGain[channel].getNextValue();
 
     if (delayLevel != nullptr) *delayLevel = std::abs (wetSample);
 
@@ -68,20 +84,38 @@ SampleType Delay< SampleType >::processChannel (int         channel,
 {
     if (numSamples == 0) return (SampleType) 0;
 
-    for (int i = 0; i < numSamples; ++i)
-        pushSample (channel, signal[i]);
+    jassert (channel < numChannels);
+
+    const auto maxChunkSize = wetBuffer.getNumSamples();
+
+    jassert (maxChunkSize > 0);  // not prepared?
+
+    if (maxChunkSize == 0) return (SampleType) 0;
+
+    auto* wet = wetBuffer.getWritePointer (0);
 
-    auto avgMag = SampleType (0.0);
+    lastInput[channel] = signal[numSamples - 1];
 
-    for (int i = 0; i < numSamples; ++i)
+    auto totalMag = SampleType (0.0);
+
+    // blocks larger than the prepared blocksize are processed in chunks that fit in the wet buffer
+    for (int pos = 0; pos < numSamples; pos += maxChunkSize)
     {
-        SampleType mag;
-        signal[i] = popSample (channel, &mag);
-        avgMag += mag;
+        const auto numThisChunk = std::min (maxChunkSize, numSamples - pos);
+        auto*      chunk        = signal + pos;
+
+        delay.process (channel, chunk, wet, numThisChunk);
+
+        dryGain[channel].applyGain (chunk, numThisChunk);
+        wetGain[channel].applyGain (wet, numThisChunk);
+
+        for (int i = 0; i < numThisChunk; ++i)
+            totalMag += std::abs (wet[i]);
+
+        vecops::addV (chunk, wet, numThisChunk);
     }
 
-    avgMag /= static_cast< SampleType > (numSamples);
-    return avgMag;
+    return totalMag / static_cast< SampleType > (numSamples);
 }
 
 template class Delay< float >;
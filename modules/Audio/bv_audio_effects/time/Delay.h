@@ -12,6 +12,9 @@ public:
 
     void reset();
 
+    /* Sets the longest delay the line can hold. Call this before prepare(). */
+    void setMaxDelay (int maxDelayInSamples);
+
     void setDelay (int delayInSamples);
     void setDryWet (int wetMixPercent);
 
@@ -24,10 +27,15 @@ private:
                                SampleType* signal,
                                const SampleType*) final;
 
-    juce::dsp::DelayLine< SampleType > delay;
-    juce::dsp::ProcessSpec             spec;
+    static constexpr int numChannels = 2;
+
+    DelayLine< SampleType > delay;
+    int                     maxDelay {96000};
+
+    juce::AudioBuffer< SampleType > wetBuffer;
+    SampleType                      lastInput[numChannels] {};
 
-    ValueSmoother< SampleType > dryGain, wetGain;
+    ValueSmoother< SampleType > dryGain[numChannels], wetGain[numChannels];
 };
 
 }  // namespace bav::dsp::FX
@@ -0,0 +1,186 @@
+
+namespace bav::dsp::FX
+{
+template < typename SampleType >
+void DelayLine< SampleType >::prepare (double samplerate, int blocksize, int numChannels, int maxDelayInSamples)
+{
+    jassert (samplerate > 0. && blocksize > 0 && numChannels > 0 && maxDelayInSamples >= 0);
+
+    lastSamplerate = samplerate;
+    maxDelay       = maxDelayInSamples;
+
+    // room for the longest delay behind a whole block, plus the extra sample a fractional read needs
+    size = maxDelay + blocksize + 1;
+
+    buffer.setSize (numChannels, size);
+    scratch.setSize (1, blocksize);
+
+    channels.resize (static_cast< size_t > (numChannels));
+
+    targetDelay = juce::jlimit (SampleType (0), static_cast< SampleType > (maxDelay), targetDelay);
+
+    for (auto& chan : channels)
+        chan.delay.reset (samplerate, rampSeconds);
+
+    reset();
+}
+
+template < typename SampleType >
+void DelayLine< SampleType >::reset()
+{
+    buffer.clear();
+
+    for (auto& chan : channels)
+    {
+        chan.writeIndex = 0;
+        chan.delay.setCurrentAndTargetValue (targetDelay);
+    }
+}
+
+template < typename SampleType >
+void DelayLine< SampleType >::setDelay (SampleType newDelayInSamples, bool snapImmediately)
+{
+    jassert (newDelayInSamples >= SampleType (0));
+
+    // prepare() limits the delay to the line's length
+    if (channels.empty())
+    {
+        targetDelay = newDelayInSamples;
+        return;
+    }
+
+    jassert (newDelayInSamples <= static_cast< SampleType > (maxDelay));
+
+    targetDelay = juce::jlimit (SampleType (0), static_cast< SampleType > (maxDelay), newDelayInSamples);
+
+    for (auto& chan : channels)
+    {
+        if (snapImmediately)
+            chan.delay.setCurrentAndTargetValue (targetDelay);
+        else
+            chan.delay.setTargetValue (targetDelay);
+    }
+}
+
+template < typename SampleType >
+void DelayLine< SampleType >::setRampTime (double seconds)
+{
+    jassert (seconds >= 0.);
+
+    rampSeconds = seconds;
+
+    if (lastSamplerate > 0.)
+        for (auto& chan : channels)
+            chan.delay.reset (lastSamplerate, rampSeconds);
+}
+
+template < typename SampleType >
+void DelayLine< SampleType >::process (int channel, const SampleType* input, SampleType* output, int numSamples)
+{
+    jassert (channel < static_cast< int > (channels.size()));
+
+    auto&      delay    = channels[static_cast< size_t > (channel)].delay;
+    const auto maxChunk = scratch.getNumSamples();
+
+    for (int start = 0; start < numSamples; start += maxChunk)
+    {
+        const auto num = std::min (maxChunk, numSamples - start);
+        auto*      out = output + start;
+
+        write (channel, input + start, num);
+
+        if (delay.isSmoothing())
+        {
+            for (int i = 0; i < num; ++i)
+                out[i] = interpolatedRead (channel, delay.getNextValue(), num - i);
+
+            continue;
+        }
+
+        const auto time     = delay.getCurrentValue();
+        const auto whole    = static_cast< int > (time);
+        const auto fraction = time - static_cast< SampleType > (whole);
+
+        read (channel, whole, out, num);
+
+        if (fraction > SampleType (0))
+        {
+            auto* older = scratch.getWritePointer (0);
+
+            read (channel, whole + 1, older, num);
+
+            vecops::multiplyC (out, SampleType (1) - fraction, num);
+            juce::FloatVectorOperations::addWithMultiply (out, older, fraction, num);
+        }
+    }
+}
+
+template < typename SampleType >
+void DelayLine< SampleType >::pushSample (int channel, SampleType sample)
+{
+    write (channel, &sample, 1);
+}
+
+template < typename SampleType >
+SampleType DelayLine< SampleType >::popSample (int channel)
+{
+    return interpolatedRead (channel, channels[static_cast< size_t > (channel)].delay.getNextValue(), 1);
+}
+
+template < typename SampleType >
+void DelayLine< SampleType >::write (int channel, const SampleType* input, int numSamples)
+{
+    auto* data  = buffer.getWritePointer (channel);
+    auto& index = channels[static_cast< size_t > (channel)].writeIndex;
+
+    const auto first = std::min (numSamples, size - index);
+
+    vecops::copy (input, data + index, first);
+    vecops::copy (input + first, data, numSamples - first);
+
+    index += numSamples;
+
+    if (index >= size)
+        index -= size;
+}
+
+template < typename SampleType >
+void DelayLine< SampleType >::read (int channel, int delayInSamples, SampleType* output, int numSamples) const
+{
+    const auto* data = buffer.getReadPointer (channel);
+
+    // the block that was just written ends at the write index
+    auto start = channels[static_cast< size_t > (channel)].writeIndex - numSamples - delayInSamples;
+
+    if (start < 0)
+        start += size;
+
+    const auto first = std::min (numSamples, size - start);
+
+    vecops::copy (data + start, output, first);
+    vecops::copy (data, output + first, numSamples - first);
+}
+
+template < typename SampleType >
+SampleType DelayLine< SampleType >::interpolatedRead (int channel, SampleType delayInSamples, int age) const
+{
+    const auto* data = buffer.getReadPointer (channel);
+
+    const auto whole    = static_cast< int > (delayInSamples);
+    const auto fraction = delayInSamples - static_cast< SampleType > (whole);
+
+    // age counts back from the write index: 1 is the most recently written sample
+    auto index = channels[static_cast< size_t > (channel)].writeIndex - age - whole;
+
+    if (index < 0)
+        index += size;
+
+    const auto older = index == 0 ? size - 1 : index - 1;
+
+    return data[index] + fraction * (data[older] - data[index]);
+}
+
+template class DelayLine< float >;
+template class DelayLine< double >;
+
+}  // namespace bav::dsp::FX
@@ -0,0 +1,59 @@
+
+#pragma once
+
+namespace bav::dsp::FX
+{
+/*
+    A multichannel delay line that moves whole blocks at a time.
+    While the delay time is constant, the read position moves in lockstep with the write position, so each block is written and read as at most two contiguous segments; a fractional delay blends two such reads.
+    While the delay time is gliding to a new value, reads fall back to per-sample linear interpolation.
+*/
+template < typename SampleType >
+class DelayLine
+{
+public:
+    /* Allocates the line, so call this from the message thread. */
+    void prepare (double samplerate, int blocksize, int numChannels, int maxDelayInSamples);
+    void reset();
+
+    /* The delay glides to the new time over the ramp time, unless snapImmediately is true or the ramp time is 0.
+       A delay set before prepare() is in place from the first sample. */
+    void       setDelay (SampleType newDelayInSamples, bool snapImmediately = false);
+    SampleType getDelay() const { return targetDelay; }
+
+    void   setRampTime (double seconds);
+    double getRampTime() const { return rampSeconds; }
+
+    int getMaxDelay() const { return maxDelay; }
+
+    /* Writes the input to the channel's line, and the delayed signal to output. input and output may point to the same samples. */
+    void process (int channel, const SampleType* input, SampleType* output, int numSamples);
+
+    void pushSample (int channel, SampleType sample);
+
+    /* Reads the channel's line, delayed relative to the last pushed sample. */
+    SampleType popSample (int channel);
+
+private:
+    struct Channel
+    {
+        int                               writeIndex {0};
+        juce::SmoothedValue< SampleType > delay;
+    };
+
+    void write (int channel, const SampleType* input, int numSamples);
+    void read (int channel, int delayInSamples, SampleType* output, int numSamples) const;
+
+    SampleType interpolatedRead (int channel, SampleType delayInSamples, int age) const;
+
+    juce::AudioBuffer< SampleType > buffer, scratch;
+    std::vector< Channel >          channels;
+
+    int size {0}, maxDelay {0};
+
+    SampleType targetDelay {0};
+
+    double lastSamplerate {0.}, rampSeconds {0.05};
+};
+
+}  // namespace bav::dsp::FX
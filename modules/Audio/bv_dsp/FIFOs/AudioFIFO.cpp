@@ -1,13 +1,6 @@
 
 namespace bav::dsp
 {
-template < typename SampleType >
-void AudioFIFO< SampleType >::pushSamples (const SampleType* samples, int numSamples)
-{
-    buffer.storeSamples (samples, numSamples);
-    numStored += numSamples;
-}
-
 static inline int getZeroesToOutput (int totalNumSamplesWanted, int numStoredSamples)
 {
     if (totalNumSamplesWanted <= numStoredSamples)
@@ -16,27 +9,27 @@ static inline int getZeroesToOutput (int totalNumSamplesWanted, int numStoredSam
     return totalNumSamplesWanted - numStoredSamples;
 }
 
+
+template < typename SampleType >
+void AudioFIFO< SampleType >::pushSamples (const SampleType* samples, int numSamples)
+{
+    buffer.storeSamples (samples, numSamples);
+
+    // if the FIFO overflows, the oldest samples are overwritten
+    numStored = std::min (numStored + numSamples, buffer.getCapacity());
+}
+
 template < typename SampleType >
 void AudioFIFO< SampleType >::popSamples (SampleType* output, int numSamples)
 {
     const auto zeroes  = getZeroesToOutput (numSamples, numStored);
     const auto samples = numSamples - zeroes;
 
-    for (int i = 0; i < zeroes; ++i)
-        output[i] = SampleType (0);
-
-    const auto bufferCapacity = buffer.getCapacity();
+    vecops::fill (output, SampleType (0), zeroes);
 
-    auto index = buffer.getLastFrameEndIndex() - samples;
-    if (index < 0) index += bufferCapacity;
+    buffer.readSamples (0, buffer.getLastFrameEndIndex() - numStored, output + zeroes, samples);
 
-    for (int i = 0; i < samples; ++i)
-    {
-        output[i + zeroes] = buffer.getSample (index++);
-        if (index >= bufferCapacity) index = 0;
-    }
-
-    numStored = std::max (0, numStored - samples);
+    numStored -= samples;
 }
 
 template < typename SampleType >
@@ -49,6 +42,7 @@ template < typename SampleType >
 void AudioFIFO< SampleType >::setMaximumSize (int maximumCapacitySamples)
 {
     buffer.resize (maximumCapacitySamples, 4);
+    numStored = 0;
 }
 
 template class AudioFIFO< float >;
@@ -56,74 +50,62 @@ template class AudioFIFO< double >;
 
 
 template < typename SampleType >
-MultiAudioFIFO< SampleType >::MultiAudioFIFO (int numChannels, int maxCapacity)
+MultiAudioFIFO< SampleType >::MultiAudioFIFO (int numChannelsToUse, int maxCapacity)
+    : numChannels (numChannelsToUse), capacity (maxCapacity)
 {
-    setNumChannels (numChannels);
     setMaximumSize (maxCapacity);
 }
 
 template < typename SampleType >
-void MultiAudioFIFO< SampleType >::setNumChannels (int numChannels)
+void MultiAudioFIFO< SampleType >::setNumChannels (int numChannelsToUse)
 {
-    while (fifos.size() < numChannels)
-    {
-        fifos.add (new AudioFIFO< SampleType >);
-    }
-
-    while (fifos.size() > numChannels)
-    {
-        fifos.removeLast();
-    }
-
+    numChannels = numChannelsToUse;
     setMaximumSize (capacity);
 }
 
 template < typename SampleType >
 void MultiAudioFIFO< SampleType >::setMaximumSize (int maximumCapacitySamples)
 {
-    for (auto* fifo : fifos)
-        fifo->setMaximumSize (maximumCapacitySamples);
-
     capacity = maximumCapacitySamples;
+
+    buffer.resize (capacity, 4, std::max (1, numChannels));
+    numStored = 0;
 }
 
 template < typename SampleType >
 int MultiAudioFIFO< SampleType >::numStoredSamples() const
 {
-    if (fifos.isEmpty())
-        return 0;
-
-    int num = std::numeric_limits< int >::max();
-
-    for (auto* fifo : fifos)
-        if (auto stored = fifo->numStoredSamples(); stored < num)
-            num = stored;
-
-    jassert (num < std::numeric_limits< int >::max());
-    return num;
+    return numStored;
 }
 
 template < typename SampleType >
 void MultiAudioFIFO< SampleType >::pushSamples (const AudioBuffer& input)
 {
-    const auto numSamples = input.getNumSamples();
-    const auto channels   = std::min (input.getNumChannels(), fifos.size());
+    buffer.storeSamples (input);
 
-    for (int i = 0; i < channels; ++i)
-        fifos[i]->pushSamples (input.getReadPointer (i), numSamples);
+    numStored = std::min (numStored + input.getNumSamples(), buffer.getCapacity());
 }
 
 template < typename SampleType >
 void MultiAudioFIFO< SampleType >::popSamples (AudioBuffer& output)
 {
     const auto numSamples = output.getNumSamples();
-    const auto channels   = std::min (output.getNumChannels(), fifos.size());
+    const auto channels   = std::min (output.getNumChannels(), numChannels);
+
+    const auto zeroes  = getZeroesToOutput (numSamples, numStored);
+    const auto samples = numSamples - zeroes;
+    const auto start   = buffer.getLastFrameEndIndex() - numStored;
 
     for (int i = 0; i < channels; ++i)
-        fifos[i]->popSamples (output.getWritePointer (i), numSamples);
+    {
+        output.clear (i, 0, zeroes);
+        buffer.readSamples (i, start, output.getWritePointer (i, zeroes), samples);
+    }
 
     for (int i = channels; i < output.getNumChannels(); ++i)
         output.clear (i, 0, numSamples);
+
+    numStored -= samples;
 }
 
 
@@ -2,7 +2,7 @@
 
 namespace bav::dsp
 {
-/* FIFO for a single channel of audio samples */
+/* FIFO for a single channel of audio samples. Popping more samples than are stored outputs zeroes before the stored samples. */
 template < typename SampleType >
 class AudioFIFO
 {
@@ -20,12 +20,11 @@ public:
 private:
     CircularBuffer< SampleType > buffer;
 
-    int writeHead {0};
     int numStored {0};
 };
 
 
-/* FIFO for multiple channels of audio */
+/* FIFO for multiple channels of audio, which are all stored in one allocation */
 template < typename SampleType >
 class MultiAudioFIFO
 {
@@ -45,9 +44,10 @@ public:
     void popSamples (AudioBuffer& output);
 
 private:
-    juce::OwnedArray< AudioFIFO< SampleType > > fifos;
+    CircularBuffer< SampleType > buffer;
 
-    int capacity {512};
+    int numChannels {2}, capacity {512};
+    int numStored {0};
 };
 
 }  // namespace bav::dsp
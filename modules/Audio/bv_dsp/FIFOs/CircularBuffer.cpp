@@ -2,94 +2,95 @@
 namespace bav::dsp
 {
 template < typename SampleType >
-void CircularBuffer< SampleType >::resize (int blocksize, int blocksizeMultipleToAllocate)
+void CircularBuffer< SampleType >::resize (int blocksize, int blocksizeMultipleToAllocate, int numChannels)
 {
-    const auto newSize = blocksize * blocksizeMultipleToAllocate;
-    buffer.setSize (1, newSize, true, true, true);
+    jassert (blocksize > 0 && blocksizeMultipleToAllocate > 0 && numChannels > 0);
 
-    lastFrameStart %= newSize;
-    lastFrameEnd %= newSize;
+    const auto newCapacity = juce::nextPowerOfTwo (blocksize * blocksizeMultipleToAllocate);
+
+    if (newCapacity != capacity || numChannels != buffer.getNumChannels())
+    {
+        buffer.setSize (numChannels, newCapacity);
+        capacity = newCapacity;
+        mask     = newCapacity - 1;
+    }
+
+    clear();
 }
 
 template < typename SampleType >
-void CircularBuffer< SampleType >::storeSamples (const AudioBuffer& samples, int channel)
+void CircularBuffer< SampleType >::clear()
 {
-    storeSamples (samples.getReadPointer (channel), samples.getNumSamples());
+    buffer.clear();
+    lastFrameStart = 0;
+    lastFrameEnd   = 0;
 }
 
 template < typename SampleType >
-void CircularBuffer< SampleType >::storeSamples (const SampleType* samples, int numSamples)
+void CircularBuffer< SampleType >::storeSamples (const AudioBuffer& samples)
 {
-    const auto bufferSize = getCapacity();
+    const auto numSamples  = samples.getNumSamples();
+    const auto numChannels = std::min (samples.getNumChannels(), getNumChannels());
 
-    jassert (numSamples > 0 && numSamples <= bufferSize);
-    lastFrameSize = numSamples;
+    jassert (numSamples <= capacity);
 
-    auto newStart = lastFrameEnd + 1;
-    if (newStart > bufferSize) newStart -= bufferSize;
+    for (int chan = 0; chan < numChannels; ++chan)
+        writeSamples (chan, lastFrameEnd, samples.getReadPointer (chan), numSamples);
 
-    lastFrameStart = newStart;
-
-    if (newStart + numSamples > bufferSize)
+    for (int chan = numChannels; chan < getNumChannels(); ++chan)
     {
-        const auto chunkAtEndOfBuffer = bufferSize - newStart;
-
-        vecops::copy (samples,
-                      buffer.getWritePointer (0, newStart),
-                      chunkAtEndOfBuffer);
-
-        const auto left = numSamples - chunkAtEndOfBuffer;
+        const auto start = lastFrameEnd;
+        const auto first = std::min (numSamples, capacity - start);
 
-        vecops::copy (samples + chunkAtEndOfBuffer,
-                      buffer.getWritePointer (0, 0),
-                      left);
-
-        lastFrameEnd = left;
+        buffer.clear (chan, start, first);
+        buffer.clear (chan, 0, numSamples - first);
     }
-    else
-    {
-        vecops::copy (samples,
-                      buffer.getWritePointer (0, newStart),
-                      numSamples);
 
-        lastFrameEnd = newStart + numSamples;
-    }
+    advanceFrame (numSamples);
 }
 
 template < typename SampleType >
-int CircularBuffer< SampleType >::getCapacity() const
+void CircularBuffer< SampleType >::storeSamples (const SampleType* samples, int numSamples)
 {
-    return buffer.getNumSamples();
-}
+    jassert (numSamples <= capacity);
 
-template < typename SampleType >
-int CircularBuffer< SampleType >::getLastFrameStartIndex() const
-{
-    return lastFrameStart;
+    writeSamples (0, lastFrameEnd, samples, numSamples);
+    advanceFrame (numSamples);
 }
 
 template < typename SampleType >
-int CircularBuffer< SampleType >::getLastFrameEndIndex() const
+void CircularBuffer< SampleType >::advanceFrame (int numSamples)
 {
-    return lastFrameEnd;
+    lastFrameStart = lastFrameEnd;
+    lastFrameEnd   = (lastFrameEnd + numSamples) & mask;
 }
 
 template < typename SampleType >
-int CircularBuffer< SampleType >::clipValueToCapacity (int value) const
+void CircularBuffer< SampleType >::readSamples (int channel, int startIndex, SampleType* output, int numSamples) const
 {
-    const auto capacity = getCapacity();
+    jassert (numSamples <= capacity);
 
-    if (value < capacity)
-        return value;
+    const auto start = startIndex & mask;
+    const auto first = std::min (numSamples, capacity - start);
 
-    return value - capacity;
+    const auto* data = buffer.getReadPointer (channel);
+
+    vecops::copy (data + start, output, first);
+    vecops::copy (data, output + first, numSamples - first);
 }
 
 template < typename SampleType >
-SampleType CircularBuffer< SampleType >::getSample (int index) const
+void CircularBuffer< SampleType >::writeSamples (int channel, int startIndex, const SampleType* input, int numSamples)
 {
-    jassert (index >= 0 && index <= getCapacity());
-    return buffer.getSample (0, index);
+    jassert (numSamples <= capacity);
+
+    const auto start = startIndex & mask;
+    const auto first = std::min (numSamples, capacity - start);
+
+    auto* data = buffer.getWritePointer (channel);
+
+    vecops::copy (input, data + start, first);
+    vecops::copy (input + first, data, numSamples - first);
 }
 
 template class CircularBuffer< float >;
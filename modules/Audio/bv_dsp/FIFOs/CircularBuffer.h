@@ -5,32 +5,56 @@
 
 namespace bav::dsp
 {
+/*
+    A ring buffer of one or more channels of audio, which stores successive frames of samples.
+    The capacity is a power of two, so indices are wrapped with a mask, and every read or write is at most two contiguous copies. All the channels live in a single allocation and share one write position.
+*/
 template < typename SampleType >
 class CircularBuffer
 {
 public:
     using AudioBuffer = juce::AudioBuffer< SampleType >;
 
-    void resize (int blocksize, int blocksizeMultipleToAllocate = 4);
+    /* Allocates at least blocksize * blocksizeMultipleToAllocate samples per channel, rounded up to a power of two, and clears the buffer. */
+    void resize (int blocksize, int blocksizeMultipleToAllocate = 4, int numChannels = 1);
 
-    void storeSamples (const AudioBuffer& samples, int channel = 0);
+    void clear();
+
+    /* Stores a new frame after the last one. Channels of this buffer that the frame doesn't have are cleared for its length. */
+    void storeSamples (const AudioBuffer& samples);
+
+    /* Stores a new frame in the first channel. */
     void storeSamples (const SampleType* samples, int numSamples);
 
-    int getCapacity() const;
-    int getLastFrameStartIndex() const;
-    int getLastFrameEndIndex() const;
+    /* Copies samples out of / into a channel, starting at any index, which is wrapped into the buffer. These don't move the frame positions. */
+    void readSamples (int channel, int startIndex, SampleType* output, int numSamples) const;
+    void writeSamples (int channel, int startIndex, const SampleType* input, int numSamples);
+
+    int getCapacity() const { return capacity; }
+    int getNumChannels() const { return buffer.getNumChannels(); }
+
+    int getLastFrameStartIndex() const { return lastFrameStart; }
 
-    int clipValueToCapacity (int value) const;
+    /* One past the last sample of the last frame, which is where the next frame will start. */
+    int getLastFrameEndIndex() const { return lastFrameEnd; }
 
-    SampleType getSample (int index) const;
+    /* Wraps any index, including a negative one, into the buffer. */
+    int clipValueToCapacity (int value) const { return value & mask; }
+
+    SampleType getSample (int index, int channel = 0) const
+    {
+        return buffer.getReadPointer (channel)[index & mask];
+    }
 
 private:
+    void advanceFrame (int numSamples);
+
     AudioBuffer buffer;
 
-    int lastFrameStart {0};  // the sample index in the buffer where the first sample of the last frame is stored
-    int lastFrameEnd {0};    // the sample index in the buffer where the last sample of the last frame is stored
+    int capacity {0}, mask {0};
 
-    int lastFrameSize {0};
+    int lastFrameStart {0};  // the sample index in the buffer where the first sample of the last frame is stored
+    int lastFrameEnd {0};    // the sample index in the buffer just past the last sample of the last frame
 };
 
 }  // namespace bav::dsp
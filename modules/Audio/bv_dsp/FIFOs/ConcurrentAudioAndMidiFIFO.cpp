@@ -0,0 +1,226 @@
+
+namespace bav::dsp
+{
+template < typename SampleType >
+ConcurrentAudioAndMidiFIFO< SampleType >::ConcurrentAudioAndMidiFIFO (int channels, int samples)
+{
+    setSize (channels, samples);
+}
+
+template < typename SampleType >
+void ConcurrentAudioAndMidiFIFO< SampleType >::setSize (int numChannels, int numSamples, int maxNumMidiEvents)
+{
+    jassert (numChannels > 0 && numSamples > 0 && maxNumMidiEvents > 0);
+
+    capacity = juce::nextPowerOfTwo (numSamples);
+    mask     = capacity - 1;
+
+    buffer.setSize (numChannels, capacity);
+    buffer.clear();
+
+    midiEvents.resize (static_cast< size_t > (juce::nextPowerOfTwo (maxNumMidiEvents)));
+    midiMask = static_cast< int > (midiEvents.size()) - 1;
+
+    pushed.samples.store (0);
+    pushed.midiEvents.store (0);
+    popped.samples.store (0);
+    popped.midiEvents.store (0);
+}
+
+template < typename SampleType >
+int ConcurrentAudioAndMidiFIFO< SampleType >::push (const AudioBuffer& audioIn, const MidiBuffer& midiIn)
+{
+    const auto writePosition = pushed.samples.load (std::memory_order_relaxed);
+    const auto readPosition  = popped.samples.load (std::memory_order_acquire);
+
+    auto       numSamples  = std::min (audioIn.getNumSamples(), capacity - static_cast< int > (writePosition - readPosition));
+    const auto numChannels = std::min (audioIn.getNumChannels(), buffer.getNumChannels());
+
+    auto       midiWrite = pushed.midiEvents.load (std::memory_order_relaxed);
+    const auto midiRead  = popped.midiEvents.load (std::memory_order_acquire);
+
+    // where the events at the current sample position start, in case they have to be taken back
+    auto firstEventAtPosition = midiWrite;
+    auto currentPosition      = -1;
+
+    for (const auto meta : midiIn)
+    {
+        if (meta.samplePosition >= numSamples) break;
+
+        if (meta.numBytes > maxMidiMessageBytes) continue;
+
+        if (meta.samplePosition != currentPosition)
+        {
+            currentPosition      = meta.samplePosition;
+            firstEventAtPosition = midiWrite;
+        }
+
+        // With the MIDI storage full, the push ends before this event's sample, so that the caller pushes it again later instead of it being lost.
+        // Events already stored at the same sample are taken back, since they'll be pushed again with it.
+        if (midiWrite - midiRead > midiMask)
+        {
+            numSamples = meta.samplePosition;
+            midiWrite  = firstEventAtPosition;
+            break;
+        }
+
+        auto& event = midiEvents[static_cast< size_t > (midiWrite & midiMask)];
+
+        event.samplePosition = writePosition + meta.samplePosition;
+        event.numBytes       = meta.numBytes;
+        std::memcpy (event.data, meta.data, static_cast< size_t > (meta.numBytes));
+
+        ++midiWrite;
+    }
+
+    const auto start = static_cast< int > (writePosition & mask);
+    const auto first = std::min (numSamples, capacity - start);
+
+    for (int chan = 0; chan < buffer.getNumChannels(); ++chan)
+    {
+        auto* data = buffer.getWritePointer (chan);
+
+        if (chan < numChannels)
+        {
+            const auto* input = audioIn.getReadPointer (chan);
+
+            vecops::copy (input, data + start, first);
+            vecops::copy (input + first, data, numSamples - first);
+        }
+        else
+        {
+            vecops::fill (data + start, SampleType (0), first);
+            vecops::fill (data, SampleType (0), numSamples - first);
+        }
+    }
+
+    // the MIDI is published first, so the consumer never sees samples without their events
+    pushed.midiEvents.store (midiWrite, std::memory_order_release);
+    pushed.samples.store (writePosition + numSamples);
+
+    if (consumerIsWaiting.load())
+        samplesPushed.signal();
+
+    return numSamples;
+}
+
+template < typename SampleType >
+void ConcurrentAudioAndMidiFIFO< SampleType >::pop (AudioBuffer& audioOut, MidiBuffer& midiOut)
+{
+    const auto readPosition  = popped.samples.load (std::memory_order_relaxed);
+    const auto writePosition = pushed.samples.load (std::memory_order_acquire);
+
+    const auto numSamples  = audioOut.getNumSamples();
+    const auto numChannels = std::min (audioOut.getNumChannels(), buffer.getNumChannels());
+
+    const auto zeroes  = std::max (0, numSamples - static_cast< int > (writePosition - readPosition));
+    const auto samples = numSamples - zeroes;
+
+    const auto start = static_cast< int > (readPosition & mask);
+    const auto first = std::min (samples, capacity - start);
+
+    for (int chan = 0; chan < numChannels; ++chan)
+    {
+        const auto* data   = buffer.getReadPointer (chan);
+        auto*       output = audioOut.getWritePointer (chan);
+
+        vecops::fill (output, SampleType (0), zeroes);
+        vecops::copy (data + start, output + zeroes, first);
+        vecops::copy (data, output + zeroes + first, samples - first);
+    }
+
+    for (int chan = numChannels; chan < audioOut.getNumChannels(); ++chan)
+        audioOut.clear (chan, 0, numSamples);
+
+    midiOut.clear();
+
+    auto       midiRead  = popped.midiEvents.load (std::memory_order_relaxed);
+    const auto midiWrite = pushed.midiEvents.load (std::memory_order_acquire);
+
+    for (; midiRead < midiWrite; ++midiRead)
+    {
+        const auto& event = midiEvents[static_cast< size_t > (midiRead & midiMask)];
+
+        if (event.samplePosition >= readPosition + samples) break;
+
+        midiOut.addEvent (event.data, event.numBytes, zeroes + static_cast< int > (event.samplePosition - readPosition));
+    }
+
+    popped.midiEvents.store (midiRead, std::memory_order_release);
+    popped.samples.store (readPosition + samples);
+
+    if (producerIsWaiting.load())
+        samplesPopped.signal();
+}
+
+template < typename SampleType >
+int ConcurrentAudioAndMidiFIFO< SampleType >::numStoredSamples() const
+{
+    return static_cast< int > (pushed.samples.load() - popped.samples.load());
+}
+
+template < typename SampleType >
+int ConcurrentAudioAndMidiFIFO< SampleType >::numFreeSamples() const
+{
+    return capacity - numStoredSamples();
+}
+
+template < typename SampleType >
+bool ConcurrentAudioAndMidiFIFO< SampleType >::waitForSamples (int numSamples, int timeoutMs)
+{
+    jassert (numSamples <= capacity);
+
+    return waitFor ([this, numSamples] { return numStoredSamples() >= numSamples; },
+                    samplesPushed, consumerIsWaiting, timeoutMs);
+}
+
+template < typename SampleType >
+bool ConcurrentAudioAndMidiFIFO< SampleType >::waitForSpace (int numSamples, int timeoutMs)
+{
+    jassert (numSamples <= capacity);
+
+    return waitFor ([this, numSamples] { return numFreeSamples() >= numSamples; },
+                    samplesPopped, producerIsWaiting, timeoutMs);
+}
+
+template < typename SampleType >
+template < typename Condition >
+bool ConcurrentAudioAndMidiFIFO< SampleType >::waitFor (Condition condition, realtime::Semaphore& wakeUp, std::atomic< bool >& isWaiting, int timeoutMs)
+{
+    const auto deadline = juce::Time::getMillisecondCounter() + static_cast< juce::uint32 > (std::max (0, timeoutMs));
+
+    // the flag is raised before the condition is checked again, and the other side publishes its position before checking the flag, so a wake-up can't be missed
+    isWaiting.store (true);
+
+    auto result = true;
+
+    while (! condition())
+    {
+        auto msToWait = -1;
+
+        if (timeoutMs >= 0)
+        {
+            msToWait = static_cast< int > (deadline - juce::Time::getMillisecondCounter());
+
+            if (msToWait <= 0)
+            {
+                result = condition();
+                break;
+            }
+        }
+
+        wakeUp.wait (msToWait);
+    }
+
+    isWaiting.store (false);
+
+    // wake-ups signalled after the condition was already met would only cost the next wait an extra check, but there's no need to keep them
+    while (wakeUp.tryWait()) { }
+
+    return result;
+}
+
+template class ConcurrentAudioAndMidiFIFO< float >;
+template class ConcurrentAudioAndMidiFIFO< double >;
+
+}  // namespace bav::dsp
@@ -0,0 +1,72 @@
+#pragma once
+
+namespace bav::dsp
+{
+/*
+    A single-producer, single-consumer FIFO of audio and MIDI, for moving audio between the audio thread and another thread, such as a disk streamer or an analysis worker.
+    One thread may push while another pops, without locks: each side owns the positions it advances and only reads the other side's, and the positions are published with release / acquire ordering. Each side's positions sit on their own cache line.
+    Pushing never overwrites samples that haven't been popped yet; a push that doesn't fit stores as much as fits. That includes the MIDI: if the MIDI storage fills up, the push stops just before the sample of the first event that didn't fit, and that event is stored by the next push of the rest of the audio. Popping more samples than are stored outputs zeroes before the stored samples, like AudioAndMidiFIFO.
+    MIDI messages longer than maxMidiMessageBytes, such as most sysex, are dropped.
+*/
+template < typename SampleType >
+class ConcurrentAudioAndMidiFIFO
+{
+public:
+    using AudioBuffer = juce::AudioBuffer< SampleType >;
+
+    static constexpr int maxMidiMessageBytes = 16;
+
+    ConcurrentAudioAndMidiFIFO (int channels = 2, int samples = 1024);
+
+    /* Allocates and clears the FIFO, rounding the sizes up to powers of two. This isn't thread-safe, so only call it while neither side is using the FIFO. */
+    void setSize (int numChannels, int numSamples, int maxNumMidiEvents = 512);
+
+    /* Called by the producer. Returns the number of samples that were stored, along with every MIDI event before them. */
+    int push (const AudioBuffer& audioIn, const MidiBuffer& midiIn);
+
+    /* Called by the consumer. */
+    void pop (AudioBuffer& audioOut, MidiBuffer& midiOut);
+
+    int numStoredSamples() const;
+    int numFreeSamples() const;
+
+    /*
+        Blocking waits, for whichever side isn't running on the audio thread. These return false if the timeout, in milliseconds, runs out first; a timeout of -1 waits forever.
+        The other side only signals a wake-up while a wait is actually in progress, and signalling never locks, so the audio thread can push or pop while the other side waits.
+    */
+    bool waitForSamples (int numSamples, int timeoutMs = -1);
+    bool waitForSpace (int numSamples, int timeoutMs = -1);
+
+private:
+    static constexpr size_t cacheLineSize = 64;
+
+    struct MidiEvent
+    {
+        juce::int64 samplePosition;
+        juce::uint8 data[maxMidiMessageBytes];
+        int         numBytes;
+    };
+
+    // counts of everything that has passed through one end of the FIFO; these only ever increase, and are masked into indices
+    struct alignas (cacheLineSize) Positions
+    {
+        std::atomic< juce::int64 > samples {0};
+        std::atomic< juce::int64 > midiEvents {0};
+    };
+
+    template < typename Condition >
+    bool waitFor (Condition condition, realtime::Semaphore& wakeUp, std::atomic< bool >& isWaiting, int timeoutMs);
+
+    AudioBuffer buffer;
+    int         capacity {0}, mask {0};
+
+    std::vector< MidiEvent > midiEvents;
+    int                      midiMask {0};
+
+    Positions pushed, popped;
+
+    realtime::Semaphore samplesPushed, samplesPopped;
+    std::atomic< bool > consumerIsWaiting {false}, producerIsWaiting {false};
+};
+
+}  // namespace bav::dsp
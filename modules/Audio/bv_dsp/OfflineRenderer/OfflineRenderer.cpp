@@ -0,0 +1,397 @@
+
+#include <iostream>
+
+namespace bav::dsp
+{
+template < typename SampleType >
+typename OfflineRenderer< SampleType >::Result OfflineRenderer< SampleType >::render (EngineType& engine, const Job& job)
+{
+    jassert (job.blocksize > 0 && job.numOutputChannels > 0);
+
+    Result result;
+
+    auto fail = [&result] (const String& message)
+    {
+        result.errorMessage = message;
+        return result;
+    };
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    std::unique_ptr< juce::AudioFormatReader > reader;
+
+    if (job.audioInput != File())
+    {
+        reader.reset (formats.createReaderFor (job.audioInput));
+
+        if (reader == nullptr)
+            return fail ("Couldn't read the audio file " + job.audioInput.getFullPathName());
+    }
+
+    juce::MidiMessageSequence midi;
+
+    if (job.midiInput != File() && ! readMidiFile (job.midiInput, midi))
+        return fail ("Couldn't read the MIDI file " + job.midiInput.getFullPathName());
+
+    const auto samplerate = reader != nullptr ? reader->sampleRate : job.samplerate;
+
+    auto toSamples = [samplerate] (double seconds) { return static_cast< juce::int64 > (std::llround (seconds * samplerate)); };
+
+    const auto inputLength = std::max (reader != nullptr ? reader->lengthInSamples : juce::int64 (0),
+                                       midi.getNumEvents() > 0 ? toSamples (midi.getEndTime()) + 1 : juce::int64 (0));
+
+    const auto renderLength = inputLength + toSamples (job.tailSeconds);
+
+    if (renderLength <= 0)
+        return fail ("There is nothing to render");
+
+    auto writer = createWriter (formats, job, samplerate);
+
+    if (writer == nullptr)
+        return fail ("Couldn't write to " + job.output.getFullPathName());
+
+    engine.prepare (samplerate, job.blocksize);
+
+    // the engine's delay is rendered on the end and trimmed off the start, so the output lines up with the input
+    const auto latency     = static_cast< juce::int64 > (engine.reportLatency());
+    const auto totalLength = renderLength + latency;
+
+    const auto numInputChannels  = reader != nullptr ? static_cast< int > (reader->numChannels) : job.numOutputChannels;
+    const auto numOutputChannels = job.numOutputChannels;
+
+    AudioBuffer input (numInputChannels, job.blocksize), output (numOutputChannels, job.blocksize);
+
+    // the file formats only read and write floats
+    juce::AudioBuffer< float > fileBuffer (std::max (numInputChannels, numOutputChannels), job.blocksize);
+
+    MidiBuffer midiBuffer;
+    midiBuffer.ensureSize (static_cast< size_t > (job.blocksize));
+
+    auto nextMidiEvent = 0;
+
+    for (juce::int64 position = 0; position < totalLength; position += job.blocksize)
+    {
+        const auto numSamples = static_cast< int > (std::min (static_cast< juce::int64 > (job.blocksize), totalLength - position));
+
+        AudioBuffer inputBlock {input.getArrayOfWritePointers(), numInputChannels, numSamples};
+        AudioBuffer outputBlock {output.getArrayOfWritePointers(), numOutputChannels, numSamples};
+
+        juce::AudioBuffer< float > inputFileBlock {fileBuffer.getArrayOfWritePointers(), numInputChannels, numSamples};
+        juce::AudioBuffer< float > outputFileBlock {fileBuffer.getArrayOfWritePointers(), numOutputChannels, numSamples};
+
+        // past the end of the file, the reader fills the block with silence
+        if (reader == nullptr)
+            inputBlock.clear();
+        else if constexpr (std::is_same_v< SampleType, float >)
+            reader->read (&inputBlock, 0, numSamples, position, true, true);
+        else
+        {
+            reader->read (&inputFileBlock, 0, numSamples, position, true, true);
+            buffers::convert (inputFileBlock, inputBlock);
+        }
+
+        midiBuffer.clear();
+
+        for (; nextMidiEvent < midi.getNumEvents(); ++nextMidiEvent)
+        {
+            const auto& message = midi.getEventPointer (nextMidiEvent)->message;
+
+            const auto samplePosition = toSamples (message.getTimeStamp()) - position;
+
+            if (samplePosition >= numSamples) break;
+
+            if (! message.isMetaEvent())
+                midiBuffer.addEvent (message, static_cast< int > (std::max (samplePosition, juce::int64 (0))));
+        }
+
+        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+        engine.process (inputBlock, outputBlock, midiBuffer);
+
+        result.processingSeconds += (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+
+        const auto numToSkip = static_cast< int > (juce::jlimit (juce::int64 (0), static_cast< juce::int64 > (numSamples), latency - position));
+
+        if (numToSkip == numSamples) continue;
+
+        if constexpr (std::is_same_v< SampleType, float >)
+            writer->writeFromAudioSampleBuffer (outputBlock, numToSkip, numSamples - numToSkip);
+        else
+        {
+            buffers::convert (outputBlock, outputFileBlock);
+            writer->writeFromAudioSampleBuffer (outputFileBlock, numToSkip, numSamples - numToSkip);
+        }
+    }
+
+    engine.releaseResources();
+
+    result.wasSuccessful = true;
+    result.numSamples    = totalLength;
+    result.samplerate    = samplerate;
+
+    return result;
+}
+
+template < typename SampleType >
+std::vector< typename OfflineRenderer< SampleType >::Result > OfflineRenderer< SampleType >::renderAll (const std::vector< Job >& jobs, EngineFactory factory, int numThreads)
+{
+    std::vector< Result > results (jobs.size());
+
+    if (jobs.empty()) return results;
+
+    std::atomic< size_t > numFinished {0};
+    juce::WaitableEvent   allFinished;
+
+    juce::ThreadPool pool (juce::jlimit (1, static_cast< int > (jobs.size()), numThreads));
+
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        pool.addJob ([&, i]
+                     {
+                         const auto& job = jobs[i];
+
+                         if (auto engine = factory (job))
+                             results[i] = render (*engine, job);
+                         else
+                             results[i].errorMessage = "The engine factory didn't create an engine";
+
+                         if (++numFinished == jobs.size())
+                             allFinished.signal();
+                     });
+    }
+
+    allFinished.wait();
+
+    return results;
+}
+
+template < typename SampleType >
+bool OfflineRenderer< SampleType >::readMidiFile (const File& file, juce::MidiMessageSequence& sequence)
+{
+    juce::FileInputStream stream (file);
+
+    if (! stream.openedOk()) return false;
+
+    juce::MidiFile midiFile;
+
+    if (! midiFile.readFrom (stream)) return false;
+
+    midiFile.convertTimestampTicksToSeconds();
+
+    sequence.clear();
+
+    for (int track = 0; track < midiFile.getNumTracks(); ++track)
+        sequence.addSequence (*midiFile.getTrack (track), 0.);
+
+    sequence.sort();
+
+    return true;
+}
+
+template < typename SampleType >
+std::unique_ptr< juce::AudioFormatWriter > OfflineRenderer< SampleType >::createWriter (juce::AudioFormatManager& formats, const Job& job, double samplerate)
+{
+    auto* format = formats.findFormatForFileExtension (job.output.getFileExtension());
+
+    if (format == nullptr)
+        format = formats.getDefaultFormat();
+
+    job.output.deleteFile();
+    job.output.getParentDirectory().createDirectory();
+
+    std::unique_ptr< juce::OutputStream > stream (job.output.createOutputStream());
+
+    if (stream == nullptr) return {};
+
+    std::unique_ptr< juce::AudioFormatWriter > writer (format->createWriterFor (stream.get(), samplerate,
+                                                                                static_cast< unsigned int > (job.numOutputChannels),
+                                                                                job.bitDepth, {}, 0));
+
+    // the writer takes ownership of the stream only if it was created
+    if (writer != nullptr)
+        stream.release();
+
+    return writer;
+}
+
+template class OfflineRenderer< float >;
+template class OfflineRenderer< double >;
+
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+
+template < typename SampleType >
+int runOfflineRenderer (int argc, char* argv[], typename OfflineRenderer< SampleType >::EngineFactory factory)
+{
+    using Renderer = OfflineRenderer< SampleType >;
+
+    const auto workingDirectory = File::getCurrentWorkingDirectory();
+
+    typename Renderer::Job defaults;
+    juce::Array< File >    audioInputs;
+    File                   outputFolder = workingDirectory;
+    auto                   numThreads   = juce::SystemStats::getNumCpus();
+
+    // each parameter's list of values; every combination of them is rendered
+    juce::StringArray                parameterNames;
+    std::vector< juce::StringArray > parameterValues;
+
+    auto printUsage = []
+    {
+        std::cout << "Usage: <renderer> [options] [audio files...]\n"
+                     "  --midi <file>            a MIDI file to play along with every audio file, or on its own for an instrument\n"
+                     "  --output <folder>        where the rendered files are written (default: the working directory)\n"
+                     "  --blocksize <samples>    the block size the engine is run with (default: 512)\n"
+                     "  --samplerate <hz>        the samplerate used when there is no audio file (default: 44100)\n"
+                     "  --channels <n>           the number of output channels (default: 2)\n"
+                     "  --bits <n>               the output bit depth (default: 24)\n"
+                     "  --tail <seconds>         extra time rendered after the inputs end (default: 0)\n"
+                     "  --jobs <n>               how many files are rendered at once (default: the number of CPUs)\n"
+                     "  --param <name=v1,v2,..>  a parameter passed to the engine; every combination of values is rendered\n";
+    };
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const String arg {argv[i]};
+
+        if (! arg.startsWith ("--"))
+        {
+            audioInputs.add (workingDirectory.getChildFile (arg));
+            continue;
+        }
+
+        if (i + 1 >= argc)
+        {
+            std::cout << "Missing a value for " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+
+        const String value {argv[++i]};
+
+        if (arg == "--midi")
+            defaults.midiInput = workingDirectory.getChildFile (value);
+        else if (arg == "--output")
+            outputFolder = workingDirectory.getChildFile (value);
+        else if (arg == "--blocksize")
+            defaults.blocksize = std::max (1, value.getIntValue());
+        else if (arg == "--samplerate")
+            defaults.samplerate = std::max (1., value.getDoubleValue());
+        else if (arg == "--channels")
+            defaults.numOutputChannels = std::max (1, value.getIntValue());
+        else if (arg == "--bits")
+            defaults.bitDepth = value.getIntValue();
+        else if (arg == "--tail")
+            defaults.tailSeconds = std::max (0., value.getDoubleValue());
+        else if (arg == "--jobs")
+            numThreads = std::max (1, value.getIntValue());
+        else if (arg == "--param" && value.containsChar ('='))
+        {
+            parameterNames.add (value.upToFirstOccurrenceOf ("=", false, false).trim());
+            parameterValues.push_back (juce::StringArray::fromTokens (value.fromFirstOccurrenceOf ("=", false, false), ",", {}));
+            parameterValues.back().trim();
+            parameterValues.back().removeEmptyStrings();
+        }
+        else
+        {
+            std::cout << "Unknown option " << arg << " " << value << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+
+    // an instrument can render just the MIDI
+    if (audioInputs.isEmpty() && defaults.midiInput != File())
+        audioInputs.add (File());
+
+    if (audioInputs.isEmpty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::vector< juce::StringPairArray > variations {{}};
+
+    for (int p = 0; p < parameterNames.size(); ++p)
+    {
+        std::vector< juce::StringPairArray > combinations;
+
+        for (const auto& variation : variations)
+        {
+            for (const auto& value : parameterValues[static_cast< size_t > (p)])
+            {
+                auto combination = variation;
+                combination.set (parameterNames[p], value);
+                combinations.push_back (combination);
+            }
+        }
+
+        variations = std::move (combinations);
+    }
+
+    std::vector< typename Renderer::Job > jobs;
+
+    for (const auto& audioInput : audioInputs)
+    {
+        const auto baseName = (audioInput != File() ? audioInput : defaults.midiInput).getFileNameWithoutExtension();
+
+        for (const auto& variation : variations)
+        {
+            auto job = defaults;
+
+            job.audioInput = audioInput;
+            job.parameters = variation;
+
+            auto name = baseName;
+
+            for (const auto& key : variation.getAllKeys())
+                name << "_" << key << "-" << variation[key];
+
+            job.output = outputFolder.getChildFile (File::createLegalFileName (name) + ".wav");
+
+            jobs.push_back (job);
+        }
+    }
+
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    const auto results = Renderer::renderAll (jobs, factory, numThreads);
+
+    const auto wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+
+    auto exitCode     = 0;
+    auto totalSamples = juce::int64 (0);
+
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        const auto& result = results[i];
+
+        std::cout << jobs[i].output.getFileName() << ": ";
+
+        if (! result.wasSuccessful)
+        {
+            std::cout << "FAILED - " << result.errorMessage << "\n";
+            exitCode = 1;
+            continue;
+        }
+
+        totalSamples += result.numSamples;
+
+        std::cout << result.numSamples << " samples in " << String (result.processingSeconds, 3) << " s, "
+                  << String (result.getSamplesPerSecond(), 0) << " samples/s ("
+                  << String (result.getRealtimeFactor(), 1) << "x realtime)\n";
+    }
+
+    if (wallSeconds > 0.)
+        std::cout << jobs.size() << " renders, " << totalSamples << " samples in " << String (wallSeconds, 3) << " s, "
+                  << String (static_cast< double > (totalSamples) / wallSeconds, 0) << " samples/s overall\n";
+
+    return exitCode;
+}
+
+template int runOfflineRenderer< float > (int, char*[], OfflineRenderer< float >::EngineFactory);
+template int runOfflineRenderer< double > (int, char*[], OfflineRenderer< double >::EngineFactory);
+
+}  // namespace bav::dsp
@@ -0,0 +1,68 @@
+#pragma once
+
+namespace bav::dsp
+{
+/*
+    Runs an Engine offline, without a plugin host: an audio file and / or a MIDI file are streamed through Engine::process() in blocks, as fast as the engine can go, and the result is written to a file.
+    Several jobs can be rendered at once, each with its own engine instance, for batch bounces, regression renders and throughput measurements.
+*/
+template < typename SampleType >
+class OfflineRenderer
+{
+public:
+    using AudioBuffer = juce::AudioBuffer< SampleType >;
+    using EngineType  = Engine< SampleType >;
+
+    struct Job
+    {
+        File audioInput;  // may be left empty for an instrument that only plays the MIDI
+        File midiInput;   // optional
+        File output;      // the format is chosen from the file extension, defaulting to WAV
+
+        double samplerate {44100.};  // only used when there's no audio input
+        int    blocksize {512};
+        int    numOutputChannels {2};
+        int    bitDepth {24};
+        double tailSeconds {0.};  // extra time rendered after the inputs end, for reverb tails and release stages
+
+        // handed to the engine factory, so that one set of inputs can be rendered with several parameter variations
+        juce::StringPairArray parameters;
+    };
+
+    struct Result
+    {
+        bool   wasSuccessful {false};
+        String errorMessage;
+
+        juce::int64 numSamples {0};
+        double      samplerate {0.};
+        double      processingSeconds {0.};  // the time spent inside Engine::process(), excluding file I/O
+
+        double getSamplesPerSecond() const { return processingSeconds > 0. ? static_cast< double > (numSamples) / processingSeconds : 0.; }
+        double getRealtimeFactor() const { return samplerate > 0. ? getSamplesPerSecond() / samplerate : 0.; }
+    };
+
+    using EngineFactory = std::function< std::unique_ptr< EngineType > (const Job&) >;
+
+    /* Renders one job on the calling thread. The engine is prepared for the job and released afterwards, and its reported latency is compensated for, so the output lines up with the input. */
+    static Result render (EngineType& engine, const Job& job);
+
+    /* Renders every job, each with its own engine from the factory, with up to numThreads jobs running at once. The results are in the same order as the jobs. */
+    static std::vector< Result > renderAll (const std::vector< Job >& jobs, EngineFactory factory, int numThreads = juce::SystemStats::getNumCpus());
+
+private:
+    // merges every track of the file into one sequence, timestamped in seconds
+    static bool readMidiFile (const File& file, juce::MidiMessageSequence& sequence);
+
+    static std::unique_ptr< juce::AudioFormatWriter > createWriter (juce::AudioFormatManager& formats, const Job& job, double samplerate);
+};
+
+
+/*
+    The body of a command-line renderer: call this from main() with a factory that creates your engine.
+    Run the program with no arguments to print the options it accepts. Returns the process's exit code.
+*/
+template < typename SampleType >
+int runOfflineRenderer (int argc, char* argv[], typename OfflineRenderer< SampleType >::EngineFactory factory);
+
+}  // namespace bav::dsp
@@ -7,19 +7,24 @@ namespace bav::dsp
 {
 template < typename SampleType >
 PitchDetector< SampleType >::PitchDetector()
-    : minHz (0), maxHz (0), lastEstimatedPeriod (0), lastFrameWasPitched (false), samplerate (0.0), confidenceThresh (static_cast< SampleType > (0.15)), asdfBuffer (0, 0)
+    : minHz (0), maxHz (0), minPeriod (0), maxPeriod (0), maxFrameSize (0), lastEstimatedPeriod (0), lastFrameWasPitched (false), samplerate (0.0), confidenceThresh (static_cast< SampleType > (0.15)), asdfBuffer (0, 0)
 {
 }
 
 
 template < typename SampleType >
-void PitchDetector< SampleType >::initialize()
+void PitchDetector< SampleType >::initialize (int newMaxFrameSize)
 {
+    jassert (newMaxFrameSize > 0);
+
+    maxFrameSize = newMaxFrameSize;
+
     periodCandidates.ensureStorageAllocated (numPeriodCandidatesToTest);
     candidateDeltas.ensureStorageAllocated (numPeriodCandidatesToTest);
     weightedCandidateConfidence.ensureStorageAllocated (numPeriodCandidatesToTest);
 
     asdfBuffer.setSize (1, 512);
+    resizeFilteringBuffer();
 
     lastFrameWasPitched = false;
 
@@ -118,6 +123,9 @@ float PitchDetector< SampleType >::detectPitch (const SampleType* inputAudio, in
 
     jassert (maxLag > minLag);
 
+    // the frame is filtered in a copy, which initialize() and setHzRange() size for the longest frame
+    jassert (numSamples <= filteringBuffer.getNumSamples());
+
     auto* reading = filteringBuffer.getWritePointer (0);
 
     // copy to filtering buffer
@@ -297,7 +305,13 @@ void PitchDetector< SampleType >::setHzRange (int newMinHz, int newMaxHz)
     const auto numOfLagValues = maxPeriod - minPeriod + 1;
 
     asdfBuffer.setSize (1, numOfLagValues, true, true, true);
-    filteringBuffer.setSize (1, numOfLagValues, true, true, true);
+    resizeFilteringBuffer();
+}
+
+template < typename SampleType >
+void PitchDetector< SampleType >::resizeFilteringBuffer()
+{
+    filteringBuffer.setSize (1, std::max (maxFrameSize, 2 * maxPeriod), true, true, true);
 }
 
 
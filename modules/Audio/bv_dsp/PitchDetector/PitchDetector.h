@@ -16,7 +16,8 @@ public:
     PitchDetector();
     ~PitchDetector() = default;
 
-    void initialize();
+    /* maxFrameSize is the longest frame that will be passed to detectPitch(). Frames also have to be at least two periods of the lowest detectable frequency long. */
+    void initialize (int maxFrameSize);
 
     void releaseResources();
 
@@ -40,9 +41,12 @@ private:
                                      const SampleType*   asdfData,
                                      int                 dataSize);
 
+    void resizeFilteringBuffer();
+
 
     int minHz, maxHz;
     int minPeriod, maxPeriod;
+    int maxFrameSize;
 
     int  lastEstimatedPeriod;
     bool lastFrameWasPitched;
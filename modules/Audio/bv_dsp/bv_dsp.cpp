@@ -4,15 +4,19 @@
 #include "FIFOs/CircularBuffer.cpp"
 #include "FIFOs/AudioFIFO.cpp"
 #include "FIFOs/AudioAndMidiFIFO.cpp"
+#include "FIFOs/ConcurrentAudioAndMidiFIFO.cpp"
 
 #include "engines/AudioEngine.cpp"
 #include "engines/LatencyEngine.cpp"
 
 #include "filters/Coeffecients.cpp"
 #include "filters/Filter.cpp"
+#include "filters/SVFilter.cpp"
 
 #include "BufferUtils/BufferUtils.cpp"
 
 #include "PitchDetector/PitchDetector.cpp"
 
 #include "BasicProcessor/BasicProcessor.cpp"
+
+#include "OfflineRenderer/OfflineRenderer.cpp"
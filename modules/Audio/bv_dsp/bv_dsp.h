@@ -18,14 +18,18 @@ END_JUCE_MODULE_DECLARATION
 #include "FIFOs/CircularBuffer.h"
 #include "FIFOs/AudioFIFO.h"
 #include "FIFOs/AudioAndMidiFIFO.h"
+#include "FIFOs/ConcurrentAudioAndMidiFIFO.h"
 
 #include "engines/AudioEngine.h"
 #include "engines/LatencyEngine.h"
 
 #include "filters/Filter.h"
+#include "filters/SVFilter.h"
 
 #include "BufferUtils/BufferUtils.h"
 
 #include "PitchDetector/PitchDetector.h"
 
 #include "BasicProcessor/BasicProcessor.h"
+
+#include "OfflineRenderer/OfflineRenderer.h"
@@ -58,6 +58,8 @@ void Engine< SampleType >::process (const AudioBuffer& input,
 template < typename SampleType >
 void Engine< SampleType >::processInternal (const AudioBuffer& input, AudioBuffer& output, MidiBuffer& midiMessages, bool isBypassed)
 {
+    BV_REALTIME_SCOPE ("dsp::Engine::process");
+
     jassert (isInitialized() && sampleRate > 0);
 
     const bool applyFadeIn                 = wasBypassedLastCallback;
@@ -34,6 +34,9 @@ public:
 
     bool isInitialized() const { return hasBeenInitialized; }
 
+    /* The first block after construction or releaseResources() is normally faded in. Call this before it for an engine whose output must start at full level, such as a control signal. */
+    void skipNextFadeIn() noexcept { wasBypassedLastCallback = false; }
+
     void prepare (double samplerate, int blocksize);
 
     void releaseResources();
@@ -1,27 +1,123 @@
 
 namespace bav::dsp
 {
+template < typename SampleType >
+class LatencyEngine< SampleType >::Worker : public juce::Thread
+{
+public:
+    Worker (LatencyEngine& engineToUse)
+        : juce::Thread ("LatencyEngine worker"), engine (engineToUse)
+    {
+    }
+
+    void run() final
+    {
+        while (! threadShouldExit())
+            if (! engine.renderNextChunkOnWorker())
+                chunksHandedOver.wait();
+    }
+
+    /* Called by the audio thread for each chunk it hands over. */
+    void wake() noexcept { chunksHandedOver.signal(); }
+
+private:
+    LatencyEngine&      engine;
+    realtime::Semaphore chunksHandedOver;
+};
+
+template < typename SampleType >
+LatencyEngine< SampleType >::~LatencyEngine()
+{
+    stopWorker();
+}
+
 template < typename SampleType >
 void LatencyEngine< SampleType >::prepared (int blocksize, double samplerate)
 {
+    // the FIFOs can't be resized while the worker is using them
+    stopWorker();
+
     chunkMidiBuffer.ensureSize (static_cast< size_t > (blocksize));
     inputFIFO.setSize (2, blocksize);
     outputFIFO.setSize (2, blocksize);
     inBuffer.setSize (2, blocksize, true, true, true);
     outBuffer.setSize (2, blocksize, true, true, true);
+
+    if (internalBlocksize > 0)
+    {
+        // the output starts with exactly the reported latency's worth of silence, so that the delay doesn't depend on the host's blocksize
+        outBuffer.clear();
+        chunkMidiBuffer.clear();
+
+        const auto numBlocksOfLatency = useWorkerThread ? 2 : 1;
+
+        for (int i = 0; i < numBlocksOfLatency; ++i)
+            outputFIFO.push (AudioBuffer {outBuffer.getArrayOfWritePointers(), 2, internalBlocksize}, chunkMidiBuffer);
+
+        if (useWorkerThread)
+        {
+            toWorker.setSize (2, blocksize * 4);
+            fromWorker.setSize (2, blocksize * 4);
+            workerInBuffer.setSize (2, blocksize, true, true, true);
+            workerOutBuffer.setSize (2, blocksize, true, true, true);
+            workerMidiBuffer.ensureSize (static_cast< size_t > (blocksize));
+
+            chunkBypassStates   = std::vector< std::atomic< bool > > (static_cast< size_t > (toWorker.numFreeSamples() / internalBlocksize + 1));
+            numChunksHandedOver = 0;
+            numChunksRendered   = 0;
+
+            if (worker == nullptr)
+                worker = std::make_unique< Worker > (*this);
+
+            worker->startThread (10);  // the highest priority, which is realtime where the platform allows it
+        }
+    }
+
     onPrepare (blocksize, samplerate);
 }
 
 template < typename SampleType >
 void LatencyEngine< SampleType >::released()
 {
+    stopWorker();
+    worker.reset();
+
     chunkMidiBuffer.clear();
     inBuffer.setSize (0, 0);
     outBuffer.setSize (0, 0);
+    workerMidiBuffer.clear();
+    workerInBuffer.setSize (0, 0);
+    workerOutBuffer.setSize (0, 0);
     internalBlocksize = 0;
     onRelease();
 }
 
+template < typename SampleType >
+void LatencyEngine< SampleType >::stopWorker()
+{
+    if (worker != nullptr)
+    {
+        worker->signalThreadShouldExit();
+        worker->wake();
+        worker->stopThread (-1);
+    }
+}
+
+template < typename SampleType >
+void LatencyEngine< SampleType >::setRenderChunksOnWorkerThread (bool shouldUseWorkerThread)
+{
+    using Engine = Engine< SampleType >;
+
+    if (useWorkerThread == shouldUseWorkerThread) return;
+
+    useWorkerThread = shouldUseWorkerThread;
+
+    if (Engine::isInitialized() && internalBlocksize > 0)
+        Engine::prepare (Engine::getSamplerate(), internalBlocksize);
+    else if (! useWorkerThread)
+        stopWorker();
+}
+
 template < typename SampleType >
 void LatencyEngine< SampleType >::changeLatency (int newInternalBlocksize)
 {
@@ -40,6 +136,11 @@ void LatencyEngine< SampleType >::renderBlock (const AudioBuffer& input, AudioBu
 
     const auto totalNumSamples = input.getNumSamples();
 
+    // In worker-thread mode, the worker may be inside renderChunk() right now, so blocks with no audio are skipped rather than rendered here. Their MIDI is passed through untouched.
+    const auto hasNoAudio = input.getNumChannels() == 0 || output.getNumChannels() == 0 || totalNumSamples == 0;
+
+    if (hasNoAudio && useWorkerThread) return;
+
     if (input.getNumChannels() == 0 || output.getNumChannels() == 0)
     {
         renderChunk (input, output, midiMessages, isBypassed);
@@ -54,6 +155,12 @@ void LatencyEngine< SampleType >::renderBlock (const AudioBuffer& input, AudioBu
         return;
     }
 
+    if (useWorkerThread)
+    {
+        renderBlockOnWorker (input, output, midiMessages, isBypassed);
+        return;
+    }
+
     inputFIFO.push (input, midiMessages);
 
     while (inputFIFO.numStoredSamples() >= internalBlocksize)
@@ -74,6 +181,68 @@ void LatencyEngine< SampleType >::renderBlock (const AudioBuffer& input, AudioBu
     outputFIFO.pop (output, midiMessages);
 }
 
+template < typename SampleType >
+void LatencyEngine< SampleType >::renderBlockOnWorker (const AudioBuffer& input, AudioBuffer& output, MidiBuffer& midiMessages, bool isBypassed)
+{
+    inputFIFO.push (input, midiMessages);
+
+    AudioBuffer inAlias {inBuffer.getArrayOfWritePointers(), 2, internalBlocksize};
+    AudioBuffer outAlias {outBuffer.getArrayOfWritePointers(), 2, internalBlocksize};
+
+    // hand every complete chunk over to the worker
+    while (inputFIFO.numStoredSamples() >= internalBlocksize)
+    {
+        inputFIFO.pop (inAlias, chunkMidiBuffer);
+
+        chunkBypassStates[static_cast< size_t > (numChunksHandedOver++ % static_cast< juce::int64 > (chunkBypassStates.size()))].store (isBypassed, std::memory_order_relaxed);
+
+        const auto numPushed = toWorker.push (inAlias, chunkMidiBuffer);
+        juce::ignoreUnused (numPushed);
+        jassert (numPushed == internalBlocksize);  // host blocks this long aren't supported in worker-thread mode
+
+        worker->wake();
+    }
+
+    // collect every chunk the worker has finished. The priming means a chunk is only due once a whole internal block has passed since it was handed over,
+    // so the audio thread only ends up waiting here if the worker has fallen behind, or if the host's block is longer than the internal block
+    while (fromWorker.numStoredSamples() >= internalBlocksize || outputFIFO.numStoredSamples() < output.getNumSamples())
+    {
+        if (fromWorker.numStoredSamples() < internalBlocksize)
+        {
+            juce::Thread::yield();
+            continue;
+        }
+
+        fromWorker.pop (outAlias, chunkMidiBuffer);
+        outputFIFO.push (outAlias, chunkMidiBuffer);
+    }
+
+    outputFIFO.pop (output, midiMessages);
+}
+
+template < typename SampleType >
+bool LatencyEngine< SampleType >::renderNextChunkOnWorker()
+{
+    if (toWorker.numStoredSamples() < internalBlocksize) return false;
+
+    BV_REALTIME_SCOPE ("dsp::LatencyEngine worker chunk");
+
+    AudioBuffer inAlias {workerInBuffer.getArrayOfWritePointers(), 2, internalBlocksize};
+    AudioBuffer outAlias {workerOutBuffer.getArrayOfWritePointers(), 2, internalBlocksize};
+
+    const auto isBypassed = chunkBypassStates[static_cast< size_t > (numChunksRendered++ % static_cast< juce::int64 > (chunkBypassStates.size()))].load (std::memory_order_relaxed);
+
+    toWorker.pop (inAlias, workerMidiBuffer);
+
+    renderChunk (inAlias, outAlias, workerMidiBuffer, isBypassed);
+
+    const auto numPushed = fromWorker.push (outAlias, workerMidiBuffer);
+    juce::ignoreUnused (numPushed);
+    jassert (numPushed == internalBlocksize);
+
+    return true;
+}
+
 template < typename SampleType >
 void LatencyEngine< SampleType >::onPrepare (int, double)
 {
@@ -3,16 +3,38 @@
 
 namespace bav::dsp
 {
+/*
+    An engine that renders in chunks of a fixed internal blocksize, whatever the host's blocksize is, at the cost of one internal block of latency.
+*/
 template < typename SampleType >
 class LatencyEngine : public Engine< SampleType >
 {
 public:
     using AudioBuffer = juce::AudioBuffer< SampleType >;
 
-    int  reportLatency() const final { return internalBlocksize; }
+    ~LatencyEngine() override;
+
+    int  reportLatency() const final { return useWorkerThread ? 2 * internalBlocksize : internalBlocksize; }
     void changeLatency (int newInternalBlocksize);
 
+    /*
+        In worker-thread mode, each complete chunk is handed to a dedicated thread while the audio thread carries on, and the rendered chunk is collected one internal block later. This spreads the cost of a large internal block evenly over the host's callbacks, for one more internal block of latency.
+        The audio thread only has to wait for the worker if a chunk is due before it is finished, which can only happen when the host's blocks are larger than the internal block.
+        Changing the mode re-prepares the engine. An engine that uses the worker thread must be released with releaseResources() before it is destroyed, since the worker calls renderChunk().
+    */
+    void setRenderChunksOnWorkerThread (bool shouldUseWorkerThread);
+    bool isRenderingChunksOnWorkerThread() const { return useWorkerThread; }
+
 private:
+    class Worker;
+
+    void renderBlockOnWorker (const AudioBuffer& input, AudioBuffer& output, MidiBuffer& midiMessages, bool isBypassed);
+
+    // called on the worker thread; returns false if there was no complete chunk to render
+    bool renderNextChunkOnWorker();
+
+    void stopWorker();
+
     void renderBlock (const AudioBuffer& input, AudioBuffer& output, MidiBuffer& midiMessages, bool isBypassed) final;
 
     void prepared (int blocksize, double samplerate) final;
@@ -27,6 +49,18 @@ private:
     AudioAndMidiFIFO< SampleType > inputFIFO, outputFIFO;
     AudioBuffer                    inBuffer, outBuffer;
     MidiBuffer                     chunkMidiBuffer;
+
+    bool useWorkerThread {false};
+
+    std::unique_ptr< Worker >                worker;
+    ConcurrentAudioAndMidiFIFO< SampleType > toWorker, fromWorker;
+    AudioBuffer                              workerInBuffer, workerOutBuffer;
+    MidiBuffer                               workerMidiBuffer;
+
+    // Each chunk's bypass state, indexed by the chunk's number, with room for every chunk that toWorker can hold.
+    // The audio thread writes a chunk's flag before pushing its samples, and the worker reads it before popping them, so a slot is never reused while its chunk is still in the FIFO.
+    std::vector< std::atomic< bool > > chunkBypassStates;
+    juce::int64                         numChunksHandedOver {0}, numChunksRendered {0};
 };
 
 }  // namespace bav::dsp
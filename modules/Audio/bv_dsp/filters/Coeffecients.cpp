@@ -1,12 +1,6 @@
 
 namespace bav::dsp::filters
 {
-template < typename T >
-Coefs< T >::Coefs()
-{
-    this->ensureStorageAllocated (8);
-}
-
 template < typename T >
 Coefs< T >& Coefs< T >::operator= (std::initializer_list< T > list)
 {
@@ -17,7 +11,14 @@ Coefs< T >& Coefs< T >::operator= (std::initializer_list< T > list)
     else if (list.size() == 8)
         a0Index = 4;
 
-    this->clearQuick();
+    // more values than the highest order takes, counting a0; the coefficients are left as they were
+    if (list.size() > values.size() + 1)
+    {
+        jassertfalse;
+        return *this;
+    }
+
+    numCoefs = 0;
 
     int index = 0;
 
@@ -26,7 +27,7 @@ Coefs< T >& Coefs< T >::operator= (std::initializer_list< T > list)
     for (auto& element : list)
     {
         if (index != a0Index)
-            this->add (element);
+            values[static_cast< size_t > (numCoefs++)] = element;
         else
             a0inv = (T) 1 / element;
 
@@ -39,6 +40,26 @@ Coefs< T >& Coefs< T >::operator= (std::initializer_list< T > list)
     return *this;
 }
 
+template < typename T >
+T& Coefs< T >::operator[] (int index) noexcept
+{
+    jassert (index >= 0 && index < numCoefs);
+    return values[static_cast< size_t > (index)];
+}
+
+template < typename T >
+const T& Coefs< T >::operator[] (int index) const noexcept
+{
+    jassert (index >= 0 && index < numCoefs);
+    return values[static_cast< size_t > (index)];
+}
+
+template < typename T >
+void Coefs< T >::fill (T value) noexcept
+{
+    std::fill (begin(), end(), value);
+}
+
 template struct Coefs< float >;
 template struct Coefs< double >;
 
@@ -47,7 +68,6 @@ template struct Coefs< double >;
 template < typename NumericType >
 Coefficients< NumericType >::Coefficients()
 {
-    coefficients.ensureStorageAllocated (8);
     coefficients.fill ((NumericType) 0);
 }
 
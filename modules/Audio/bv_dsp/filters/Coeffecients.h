@@ -2,11 +2,33 @@
 
 namespace bav::dsp::filters
 {
+/* The highest filter order that Coefficients can describe. */
+static constexpr int maxFilterOrder = 3;
+
+/* Normalised coefficients, stored inline: b0..bN followed by a1..aN. A list with more values than maxFilterOrder allows is ignored. */
 template < typename T >
-struct Coefs : juce::Array< T >
+struct Coefs
 {
-    Coefs();
     Coefs& operator= (std::initializer_list< T > list);
+
+    int size() const noexcept { return numCoefs; }
+
+    T&       operator[] (int index) noexcept;
+    const T& operator[] (int index) const noexcept;
+
+    T*       data() noexcept { return values.data(); }
+    const T* data() const noexcept { return values.data(); }
+
+    T*       begin() noexcept { return values.data(); }
+    T*       end() noexcept { return values.data() + numCoefs; }
+    const T* begin() const noexcept { return values.data(); }
+    const T* end() const noexcept { return values.data() + numCoefs; }
+
+    void fill (T value) noexcept;
+
+private:
+    std::array< T, maxFilterOrder * 2 + 1 > values {};
+    int                                     numCoefs {0};
 };
 
 /*--------------------------------------------------------------------------------------------------------------*/
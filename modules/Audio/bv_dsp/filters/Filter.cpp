@@ -3,25 +3,76 @@
 
 namespace bav::dsp::filters
 {
-template < typename SampleType >
-void Filter< SampleType >::reset (SampleType resetToValue)
+/* Transposed direct form II, with the loop over the state variables unrolled for the given order. */
+template < int Order, typename SampleType >
+static inline void processFixedOrder (SampleType* buffer, int numSamples, const SampleType* coeffs, SampleType* state) noexcept
+{
+    std::array< SampleType, Order > lv;
+    std::copy (state, state + Order, lv.begin());
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto input  = buffer[i];
+        const auto output = (input * coeffs[0]) + lv[0];
+        buffer[i]         = output;
+
+        for (int j = 0; j < Order - 1; ++j)
+            lv[j] = (input * coeffs[j + 1]) - (output * coeffs[Order + j + 1]) + lv[j + 1];
+
+        lv[Order - 1] = (input * coeffs[Order]) - (output * coeffs[Order * 2]);
+    }
+
+    for (int j = 0; j < Order; ++j)
+    {
+        juce::dsp::util::snapToZero (lv[j]);
+        state[j] = lv[j];
+    }
+}
+
+template < typename SampleType, int Order >
+void StaticFilter< SampleType, Order >::reset (SampleType resetToValue) noexcept
 {
-    order = coefs.getFilterOrder();
-    state.ensureStorageAllocated (order);
     state.fill (resetToValue);
 }
 
+template < typename SampleType, int Order >
+void StaticFilter< SampleType, Order >::setCoefficients (const Coefficients< SampleType >& newCoefs) noexcept
+{
+    jassert (newCoefs.getFilterOrder() == Order);
+
+    const auto* raw = newCoefs.getRawCoefficients();
+    std::copy (raw, raw + coefficients.size(), coefficients.begin());
+}
+
+template < typename SampleType, int Order >
+void StaticFilter< SampleType, Order >::process (SampleType* buffer, int numSamples) noexcept
+{
+    processFixedOrder< Order > (buffer, numSamples, coefficients.data(), state.data());
+}
+
+template class StaticFilter< float, 1 >;
+template class StaticFilter< float, 2 >;
+template class StaticFilter< float, 3 >;
+template class StaticFilter< double, 1 >;
+template class StaticFilter< double, 2 >;
+template class StaticFilter< double, 3 >;
+
+/*--------------------------------------------------------------------------------------------------------------*/
+
 template < typename SampleType >
-void Filter< SampleType >::prepare() noexcept
+void Filter< SampleType >::reset (SampleType resetToValue)
 {
-    reset();
+    order = coefs.getFilterOrder();
+
+    firstOrder.reset (resetToValue);
+    secondOrder.reset (resetToValue);
+    thirdOrder.reset (resetToValue);
 }
 
 template < typename SampleType >
-void Filter< SampleType >::snapToZero() noexcept
+void Filter< SampleType >::prepare() noexcept
 {
-    for (auto& e : state)
-        juce::dsp::util::snapToZero (e);
+    reset();
 }
 
 template < typename SampleType >
@@ -30,174 +81,208 @@ void Filter< SampleType >::process (SampleType* buffer, int numSamples)
     if (order != coefs.getFilterOrder())
         reset();
 
-    auto src    = buffer;
-    auto dst    = buffer;
-    auto coeffs = coefs.getRawCoefficients();
-
     switch (order)
     {
-        case 1 :
-        {
-            auto b0 = coeffs[0];
-            auto b1 = coeffs[1];
-            auto a1 = coeffs[2];
+        case 1 : processWith (firstOrder, buffer, numSamples); break;
+        case 2 : processWith (secondOrder, buffer, numSamples); break;
+        case 3 : processWith (thirdOrder, buffer, numSamples); break;
+        default : break;
+    }
+}
 
-            auto lv1 = state[0];
+/* The coefficients are copied in every block, since they can be changed at any time without the order changing; for at most seven values, that is far cheaper than the block itself. */
+template < typename SampleType >
+template < int Order >
+void Filter< SampleType >::processWith (StaticFilter< SampleType, Order >& filter, SampleType* buffer, int numSamples) noexcept
+{
+    filter.setCoefficients (coefs);
+    filter.process (buffer, numSamples);
+}
 
-            for (int i = 0; i < numSamples; ++i)
-            {
-                auto input  = src[i];
-                auto output = input * b0 + lv1;
+template class Filter< float >;
+template class Filter< double >;
 
-                dst[i] = output;
 
-                lv1 = (input * b1) - (output * a1);
-            }
+/*--------------------------------------------------------------------------------------------------------------*/
 
-            juce::dsp::util::snapToZero (lv1);
-            state.set (0, lv1);
-        }
-        break;
+/* These process numLanes channels in step, with one lane per channel. */
+template < size_t numLanes, typename SampleType >
+static inline void processFirstOrderLanes (SampleType* const* channels, int numSamples, const SampleType* coeffs, SampleType* state) noexcept
+{
+    const auto b0 = coeffs[0];
+    const auto b1 = coeffs[1];
+    const auto a1 = coeffs[2];
 
-        case 2 :
-        {
-            auto b0 = coeffs[0];
-            auto b1 = coeffs[1];
-            auto b2 = coeffs[2];
-            auto a1 = coeffs[3];
-            auto a2 = coeffs[4];
-
-            auto lv1 = state[0];
-            auto lv2 = state[1];
-
-            for (int i = 0; i < numSamples; ++i)
-            {
-                auto input  = src[i];
-                auto output = (input * b0) + lv1;
-                dst[i]      = output;
-
-                lv1 = (input * b1) - (output * a1) + lv2;
-                lv2 = (input * b2) - (output * a2);
-            }
-
-            juce::dsp::util::snapToZero (lv1);
-            state.set (0, lv1);
-            juce::dsp::util::snapToZero (lv2);
-            state.set (1, lv2);
-        }
-        break;
+    SampleType lv1[numLanes];
+    std::copy (state, state + numLanes, lv1);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // every lane is loaded before any is stored, so the lanes can be computed together even if the channel pointers could alias
+        SampleType input[numLanes], output[numLanes];
 
-        case 3 :
+        for (size_t c = 0; c < numLanes; ++c)
+            input[c] = channels[c][i];
+
+        for (size_t c = 0; c < numLanes; ++c)
         {
-            auto b0 = coeffs[0];
-            auto b1 = coeffs[1];
-            auto b2 = coeffs[2];
-            auto b3 = coeffs[3];
-            auto a1 = coeffs[4];
-            auto a2 = coeffs[5];
-            auto a3 = coeffs[6];
-
-            auto lv1 = state[0];
-            auto lv2 = state[1];
-            auto lv3 = state[2];
-
-            for (int i = 0; i < numSamples; ++i)
-            {
-                auto input  = src[i];
-                auto output = (input * b0) + lv1;
-                dst[i]      = output;
-
-                lv1 = (input * b1) - (output * a1) + lv2;
-                lv2 = (input * b2) - (output * a2) + lv3;
-                lv3 = (input * b3) - (output * a3);
-            }
-
-            juce::dsp::util::snapToZero (lv1);
-            state.set (0, lv1);
-            juce::dsp::util::snapToZero (lv2);
-            state.set (1, lv2);
-            juce::dsp::util::snapToZero (lv3);
-            state.set (2, lv3);
+            output[c] = input[c] * b0 + lv1[c];
+            lv1[c]    = (input[c] * b1) - (output[c] * a1);
         }
-        break;
 
-        default :
-        {
-            for (int i = 0; i < numSamples; ++i)
-            {
-                auto input  = src[i];
-                auto output = (input * coeffs[0]) + state[0];
-                dst[i]      = output;
+        for (size_t c = 0; c < numLanes; ++c)
+            channels[c][i] = output[c];
+    }
 
-                for (int j = 0; j < order - 1; ++j)
-                    state.set (j, (input * coeffs[j + 1])
-                                      - (output * coeffs[order + j + 1]) + state[j + 1]);
+    for (size_t c = 0; c < numLanes; ++c)
+    {
+        juce::dsp::util::snapToZero (lv1[c]);
+        state[c] = lv1[c];
+    }
+}
 
-                state.set (order - 1,
-                           (input * coeffs[order]) - (output * coeffs[order * 2]));
-            }
+/* Each lane's second state variable is stride samples after its first, so a single lane of a wider filter can be processed on its own. */
+template < size_t numLanes, typename SampleType >
+static inline void processBiquadLanes (SampleType* const* channels, int numSamples, const SampleType* coeffs, SampleType* state, size_t stride) noexcept
+{
+    const auto b0 = coeffs[0];
+    const auto b1 = coeffs[1];
+    const auto b2 = coeffs[2];
+    const auto a1 = coeffs[3];
+    const auto a2 = coeffs[4];
+
+    SampleType lv1[numLanes], lv2[numLanes];
+    std::copy (state, state + numLanes, lv1);
+    std::copy (state + stride, state + stride + numLanes, lv2);
 
-            snapToZero();
+    for (int i = 0; i < numSamples; ++i)
+    {
+        SampleType input[numLanes], output[numLanes];
+
+        for (size_t c = 0; c < numLanes; ++c)
+            input[c] = channels[c][i];
+
+        for (size_t c = 0; c < numLanes; ++c)
+        {
+            output[c] = (input[c] * b0) + lv1[c];
+            lv1[c]    = (input[c] * b1) - (output[c] * a1) + lv2[c];
+            lv2[c]    = (input[c] * b2) - (output[c] * a2);
         }
+
+        for (size_t c = 0; c < numLanes; ++c)
+            channels[c][i] = output[c];
+    }
+
+    for (size_t c = 0; c < numLanes; ++c)
+    {
+        juce::dsp::util::snapToZero (lv1[c]);
+        juce::dsp::util::snapToZero (lv2[c]);
+        state[c]          = lv1[c];
+        state[c + stride] = lv2[c];
     }
 }
 
-template class Filter< float >;
-template class Filter< double >;
+/* Any order, one channel. Its state variables are laid out stride samples apart. */
+template < typename SampleType >
+static inline void processLane (SampleType* audio, int numSamples, const SampleType* coeffs, int order, SampleType* state, size_t stride) noexcept
+{
+    const auto last = static_cast< size_t > (order - 1) * stride;
 
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto input  = audio[i];
+        const auto output = (input * coeffs[0]) + state[0];
+        audio[i]          = output;
 
-/*--------------------------------------------------------------------------------------------------------------*/
+        for (int j = 0; j < order - 1; ++j)
+        {
+            const auto s = static_cast< size_t > (j) * stride;
+            state[s]     = (input * coeffs[j + 1]) - (output * coeffs[order + j + 1]) + state[s + stride];
+        }
 
-template < typename SampleType, size_t numChannels >
-MultiFilter< SampleType, numChannels >::MultiFilter()
-{
-    while ((size_t) filters.size() < numChannels)
-        filters.add (new Filter< SampleType >);
+        state[last] = (input * coeffs[order]) - (output * coeffs[order * 2]);
+    }
+
+    for (int j = 0; j < order; ++j)
+        juce::dsp::util::snapToZero (state[static_cast< size_t > (j) * stride]);
 }
 
 template < typename SampleType, size_t numChannels >
 void MultiFilter< SampleType, numChannels >::prepare() noexcept
 {
-    for (auto& filter : filters)
-        filter->prepare();
+    reset();
 }
 
 template < typename SampleType, size_t numChannels >
 void MultiFilter< SampleType, numChannels >::reset (SampleType resetToValue)
 {
-    for (auto& filter : filters)
-        filter->reset (resetToValue);
+    order = coefs.getFilterOrder();
+    state.fill (resetToValue);
 }
 
 template < typename SampleType, size_t numChannels >
 void MultiFilter< SampleType, numChannels >::process (AudioBuffer& buffer) noexcept
 {
-    for (auto& filter : filters)
-        filter->coefs = coefs;
+    const auto numSamples = buffer.getNumSamples();
 
-    for (int channel = 0;
-         channel < std::min (buffer.getNumChannels(), (int) numChannels);
-         ++channel)
+    if (buffer.getNumChannels() < static_cast< int > (numChannels))
     {
-        filters[channel]->process (buffer.getWritePointer (channel),
-                                   buffer.getNumSamples());
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            processChannel (channel, buffer.getWritePointer (channel), numSamples);
+
+        return;
     }
+
+    if (order != coefs.getFilterOrder())
+        reset();
+
+    processLanes (buffer.getArrayOfWritePointers(), numSamples);
 }
 
 template < typename SampleType, size_t numChannels >
-void MultiFilter< SampleType, numChannels >::processChannel (int channel, SampleType* audio, int numSamples) noexcept
+void MultiFilter< SampleType, numChannels >::processLanes (SampleType* const* channels, int numSamples) noexcept
 {
-    if (channel < filters.size())
+    const auto* coeffs = coefs.getRawCoefficients();
+
+    switch (order)
     {
-        filters[channel]->coefs = coefs;
+        case 0 : break;
+        case 1 : processFirstOrderLanes< numChannels > (channels, numSamples, coeffs, state.data()); break;
+        case 2 : processBiquadLanes< numChannels > (channels, numSamples, coeffs, state.data(), numChannels); break;
+        default :
+            for (size_t channel = 0; channel < numChannels; ++channel)
+                processLane (channels[channel], numSamples, coeffs, order, state.data() + channel, numChannels);
+    }
+}
+
+template < typename SampleType, size_t numChannels >
+void MultiFilter< SampleType, numChannels >::processChannel (int channel, SampleType* audio, int numSamples) noexcept
+{
+    if (channel < 0 || channel >= static_cast< int > (numChannels))
+        return;
 
-        filters[channel]->process (audio, numSamples);
+    if (order != coefs.getFilterOrder())
+        reset();
+
+    const auto* coeffs = coefs.getRawCoefficients();
+    auto*       lane   = state.data() + channel;
+
+    switch (order)
+    {
+        case 0 : break;
+        case 1 : processFirstOrderLanes< 1 > (&audio, numSamples, coeffs, lane); break;
+        case 2 : processBiquadLanes< 1 > (&audio, numSamples, coeffs, lane, numChannels); break;
+        default : processLane (audio, numSamples, coeffs, order, lane, numChannels);
     }
 }
 
 template struct MultiFilter< float, 1 >;
 template struct MultiFilter< float, 2 >;
+template struct MultiFilter< float, 4 >;
+template struct MultiFilter< float, 8 >;
 template struct MultiFilter< double, 1 >;
 template struct MultiFilter< double, 2 >;
+template struct MultiFilter< double, 4 >;
+template struct MultiFilter< double, 8 >;
 
 }  // namespace bav::dsp::filters
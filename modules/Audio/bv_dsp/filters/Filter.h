@@ -4,6 +4,33 @@
 
 namespace bav::dsp::filters
 {
+/*
+    A filter whose order is fixed at compile time. Its coefficients and state are stored inline, and the per-sample recursion is fully unrolled.
+*/
+template < typename SampleType, int Order >
+class StaticFilter
+{
+public:
+    static_assert (Order > 0 && Order <= maxFilterOrder, "Unsupported filter order");
+
+    void reset (SampleType resetToValue = SampleType (0)) noexcept;
+
+    /* The coefficients must be of this filter's order. */
+    void setCoefficients (const Coefficients< SampleType >& newCoefs) noexcept;
+
+    void process (SampleType* buffer, int numSamples) noexcept;
+
+    std::array< SampleType, Order * 2 + 1 > coefficients {};
+
+private:
+    std::array< SampleType, Order > state {};
+};
+
+/*--------------------------------------------------------------------------------------------------------------*/
+
+/*
+    A filter whose order follows its coefficients. The order is checked once per block, and the block is then processed by the StaticFilter of that order.
+*/
 template < typename SampleType >
 class Filter
 {
@@ -16,29 +43,41 @@ public:
     Coefficients< SampleType > coefs;
 
 private:
-    void snapToZero() noexcept;
+    template < int Order >
+    void processWith (StaticFilter< SampleType, Order >& filter, SampleType* buffer, int numSamples) noexcept;
 
-    juce::Array< SampleType > state;
-    int                       order = 0;
+    StaticFilter< SampleType, 1 > firstOrder;
+    StaticFilter< SampleType, 2 > secondOrder;
+    StaticFilter< SampleType, 3 > thirdOrder;
+
+    int order = 0;
 };
 
 /*--------------------------------------------------------------------------------------------------------------*/
 
+/*
+    Filters several channels with the same coefficients.
+    The channels' states are stored interleaved, one lane per channel, so when all the channels are processed together, each sample step updates every channel at once and can be vectorised across them.
+*/
 template < typename SampleType, size_t numChannels = 2 >
 struct MultiFilter
 {
     using AudioBuffer = juce::AudioBuffer< SampleType >;
 
-    MultiFilter();
-
     void reset (SampleType resetToValue = SampleType (0));
     void prepare() noexcept;
 
     void process (AudioBuffer& buffer) noexcept;
     void processChannel (int channel, SampleType* audio, int numSamples) noexcept;
 
-    Coefficients< SampleType >               coefs;
-    juce::OwnedArray< Filter< SampleType > > filters;
+    Coefficients< SampleType > coefs;
+
+private:
+    void processLanes (SampleType* const* channels, int numSamples) noexcept;
+
+    // state[j * numChannels + channel] is the j-th state variable of that channel
+    std::array< SampleType, maxFilterOrder * numChannels > state {};
+    int                                                    order = 0;
 };
 
 }  // namespace bav::dsp::filters
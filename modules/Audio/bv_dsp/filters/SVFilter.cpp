@@ -0,0 +1,192 @@
+
+namespace bav::dsp::filters
+{
+static constexpr int    tanTableSize           = 2048;
+static constexpr double maxNormalisedFrequency = 0.49;
+
+/* tan (pi * f / samplerate), sampled over 0 <= f / samplerate <= maxNormalisedFrequency, plus one guard point. */
+template < typename SampleType >
+static const std::array< SampleType, tanTableSize + 2 >& getTanTable()
+{
+    static const auto table = []
+    {
+        std::array< SampleType, tanTableSize + 2 > t;
+
+        for (size_t i = 0; i < t.size(); ++i)
+            t[i] = static_cast< SampleType > (std::tan (juce::MathConstants< double >::pi * maxNormalisedFrequency
+                                                        * static_cast< double > (i) / static_cast< double > (tanTableSize)));
+
+        return t;
+    }();
+
+    return table;
+}
+
+template < typename SampleType >
+void SVFilter< SampleType >::prepare (double samplerate)
+{
+    jassert (samplerate > 0.);
+
+    invSamplerate = static_cast< SampleType > (1. / samplerate);
+
+    // builds the table now, rather than on the audio thread
+    getTanTable< SampleType >();
+
+    reset();
+}
+
+template < typename SampleType >
+void SVFilter< SampleType >::reset()
+{
+    ic1eq    = SampleType (0);
+    ic2eq    = SampleType (0);
+    currentG = gainForCutoff (cutoff);
+    currentK = SampleType (1) / Q;
+}
+
+template < typename SampleType >
+void SVFilter< SampleType >::setType (SVFilterType newType)
+{
+    type = newType;
+}
+
+template < typename SampleType >
+SVFilterType SVFilter< SampleType >::getType() const
+{
+    return type;
+}
+
+template < typename SampleType >
+void SVFilter< SampleType >::setCutoff (SampleType freqHz)
+{
+    jassert (freqHz > SampleType (0));
+    cutoff = freqHz;
+}
+
+template < typename SampleType >
+SampleType SVFilter< SampleType >::getCutoff() const
+{
+    return cutoff;
+}
+
+template < typename SampleType >
+void SVFilter< SampleType >::setQfactor (SampleType newQ)
+{
+    jassert (newQ > SampleType (0));
+    Q = newQ;
+}
+
+template < typename SampleType >
+SampleType SVFilter< SampleType >::getQfactor() const
+{
+    return Q;
+}
+
+template < typename SampleType >
+SampleType SVFilter< SampleType >::gainForCutoff (SampleType freqHz) const noexcept
+{
+    const auto& table = getTanTable< SampleType >();
+
+    const auto normalised = juce::jlimit (SampleType (0), static_cast< SampleType > (maxNormalisedFrequency), freqHz * invSamplerate);
+    const auto position   = normalised * static_cast< SampleType > (tanTableSize / maxNormalisedFrequency);
+    const auto index      = static_cast< size_t > (position);
+    const auto frac       = position - static_cast< SampleType > (index);
+
+    return table[index] + frac * (table[index + 1] - table[index]);
+}
+
+template < typename SampleType >
+void SVFilter< SampleType >::process (SampleType* buffer, int numSamples) noexcept
+{
+    if (numSamples <= 0) return;
+
+    const auto startG = currentG;
+    const auto step   = (gainForCutoff (cutoff) - startG) / static_cast< SampleType > (numSamples);
+
+    dispatch (buffer, numSamples, [startG, step] (int i)
+              { return startG + step * static_cast< SampleType > (i + 1); });
+
+    currentG = gainForCutoff (cutoff);
+}
+
+template < typename SampleType >
+void SVFilter< SampleType >::process (SampleType* buffer, const SampleType* cutoffHz, int numSamples) noexcept
+{
+    if (numSamples <= 0) return;
+
+    dispatch (buffer, numSamples, [this, cutoffHz] (int i)
+              { return gainForCutoff (cutoffHz[i]); });
+
+    cutoff   = cutoffHz[numSamples - 1];
+    currentG = gainForCutoff (cutoff);
+}
+
+template < typename SampleType >
+template < typename GainFunction >
+void SVFilter< SampleType >::dispatch (SampleType* buffer, int numSamples, GainFunction&& gainForSample) noexcept
+{
+    switch (type)
+    {
+        case (LowPassSVF) : processInternal< LowPassSVF > (buffer, numSamples, gainForSample); break;
+        case (HighPassSVF) : processInternal< HighPassSVF > (buffer, numSamples, gainForSample); break;
+        case (BandPassSVF) : processInternal< BandPassSVF > (buffer, numSamples, gainForSample); break;
+        case (NotchSVF) : processInternal< NotchSVF > (buffer, numSamples, gainForSample); break;
+        case (PeakSVF) : processInternal< PeakSVF > (buffer, numSamples, gainForSample); break;
+        case (AllPassSVF) : processInternal< AllPassSVF > (buffer, numSamples, gainForSample); break;
+    }
+}
+
+template < typename SampleType >
+template < SVFilterType Type, typename GainFunction >
+void SVFilter< SampleType >::processInternal (SampleType* buffer, int numSamples, GainFunction&& gainForSample) noexcept
+{
+    const auto targetK = SampleType (1) / Q;
+    const auto kStep   = (targetK - currentK) / static_cast< SampleType > (numSamples);
+
+    auto k  = currentK;
+    auto s1 = ic1eq;
+    auto s2 = ic2eq;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        k += kStep;
+
+        const auto g  = gainForSample (i);
+        const auto a1 = SampleType (1) / (SampleType (1) + g * (g + k));
+        const auto a2 = g * a1;
+        const auto a3 = g * a2;
+
+        const auto v0 = buffer[i];
+        const auto v3 = v0 - s2;
+        const auto v1 = a1 * s1 + a2 * v3;
+        const auto v2 = s2 + a2 * s1 + a3 * v3;
+
+        s1 = SampleType (2) * v1 - s1;
+        s2 = SampleType (2) * v2 - s2;
+
+        if constexpr (Type == LowPassSVF)
+            buffer[i] = v2;
+        else if constexpr (Type == HighPassSVF)
+            buffer[i] = v0 - k * v1 - v2;
+        else if constexpr (Type == BandPassSVF)
+            buffer[i] = k * v1;  // unity gain at the centre frequency
+        else if constexpr (Type == NotchSVF)
+            buffer[i] = v0 - k * v1;
+        else if constexpr (Type == PeakSVF)
+            buffer[i] = SampleType (2) * v2 - v0 + k * v1;
+        else
+            buffer[i] = v0 - SampleType (2) * k * v1;
+    }
+
+    juce::dsp::util::snapToZero (s1);
+    juce::dsp::util::snapToZero (s2);
+
+    ic1eq    = s1;
+    ic2eq    = s2;
+    currentK = targetK;
+}
+
+template class SVFilter< float >;
+template class SVFilter< double >;
+
+}  // namespace bav::dsp::filters
@@ -0,0 +1,60 @@
+#pragma once
+
+namespace bav::dsp::filters
+{
+enum SVFilterType
+{
+    LowPassSVF,
+    HighPassSVF,
+    BandPassSVF,
+    NotchSVF,
+    PeakSVF,
+    AllPassSVF
+};
+
+/*
+    A topology-preserving state variable filter, meant for modulation.
+    Its coefficients come from a cached tan() table and are recalculated for every sample, so the cutoff can move at audio rate without redesigning the filter or resetting its state.
+    Changes made with setCutoff() and setQfactor() are interpolated across the next processed block.
+*/
+template < typename SampleType >
+class SVFilter
+{
+public:
+    void prepare (double samplerate);
+    void reset();
+
+    void         setType (SVFilterType newType);
+    SVFilterType getType() const;
+
+    void       setCutoff (SampleType freqHz);
+    SampleType getCutoff() const;
+
+    void       setQfactor (SampleType newQ);
+    SampleType getQfactor() const;
+
+    void process (SampleType* buffer, int numSamples) noexcept;
+
+    /* Uses one cutoff frequency per sample, e.g. from an envelope or an LFO ramp. */
+    void process (SampleType* buffer, const SampleType* cutoffHz, int numSamples) noexcept;
+
+private:
+    template < SVFilterType Type, typename GainFunction >
+    void processInternal (SampleType* buffer, int numSamples, GainFunction&& gainForSample) noexcept;
+
+    template < typename GainFunction >
+    void dispatch (SampleType* buffer, int numSamples, GainFunction&& gainForSample) noexcept;
+
+    SampleType gainForCutoff (SampleType freqHz) const noexcept;
+
+    SVFilterType type {LowPassSVF};
+
+    SampleType cutoff {1000}, Q {static_cast< SampleType > (0.70710678118654752440L)};
+    SampleType currentG {0}, currentK {0};
+
+    SampleType ic1eq {0}, ic2eq {0};
+
+    SampleType invSamplerate {static_cast< SampleType > (1. / 44100.)};
+};
+
+}  // namespace bav::dsp::filters
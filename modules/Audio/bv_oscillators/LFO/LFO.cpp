@@ -1,17 +1,131 @@
 
 namespace bav::dsp
 {
+template < typename SampleType >
+void LFO< SampleType >::prepare (int blocksize, double samplerate)
+{
+    jassert (blocksize > 0 && samplerate > 0.);
+
+    lastBlocksize  = blocksize;
+    lastSamplerate = samplerate;
+
+    currentValue        = SampleType (0);
+    targetValue         = SampleType (0);
+    samplesIntoInterval = 0;
+    numControlValues    = 0;
+    lastNumSamples      = 0;
+    primed              = false;
+
+    // the oscillator itself runs at the decimated rate, so its frequency setting stays in Hz
+    const auto maxValues = interval > 1 ? std::max (2, blocksize / interval + 1) : blocksize;
+
+    osc::ChoosableOscillator< SampleType >::prepare (maxValues, samplerate / static_cast< double > (interval));
+}
+
 template < typename SampleType >
 void LFO< SampleType >::prepared (int blocksize)
 {
     storage.setSize (1, blocksize, true, true, true);
 }
 
+template < typename SampleType >
+void LFO< SampleType >::setControlRateInterval (int samplesPerValue)
+{
+    jassert (samplesPerValue > 0);
+
+    if (samplesPerValue == interval) return;
+
+    interval = samplesPerValue;
+
+    if (lastSamplerate > 0.)
+        prepare (lastBlocksize, lastSamplerate);
+}
+
 template < typename SampleType >
 void LFO< SampleType >::process (int numSamples)
 {
-    AudioBuffer alias {storage.getArrayOfWritePointers(), 1, numSamples};
+    jassert (numSamples <= lastBlocksize);
+
+    if (! primed)
+    {
+        // the LFO's output is a control signal, so its first values mustn't be faded or crossfaded in like audio
+        osc::ChoosableOscillator< SampleType >::startWithoutFade();
+
+        if (interval > 1)
+        {
+            // the first interval needs both of its endpoints, so that the ramp doesn't lag behind the oscillator
+            AudioBuffer alias {storage.getArrayOfWritePointers(), 1, 2};
+            osc::ChoosableOscillator< SampleType >::process (alias);
+
+            currentValue = alias.getSample (0, 0);
+            targetValue  = alias.getSample (0, 1);
+        }
+
+        primed = true;
+    }
+
+    blockStartValue  = currentValue;
+    blockStartTarget = targetValue;
+    blockStartOffset = samplesIntoInterval;
+    lastNumSamples   = numSamples;
+
+    numControlValues = interval > 1 ? (samplesIntoInterval + numSamples) / interval : numSamples;
+
+    if (numControlValues == 0)
+    {
+        samplesIntoInterval += numSamples;
+        return;
+    }
+
+    AudioBuffer alias {storage.getArrayOfWritePointers(), 1, numControlValues};
     osc::ChoosableOscillator< SampleType >::process (alias);
+
+    if (interval == 1) return;
+
+    const auto* values = storage.getReadPointer (0);
+
+    currentValue        = numControlValues > 1 ? values[numControlValues - 2] : targetValue;
+    targetValue         = values[numControlValues - 1];
+    samplesIntoInterval = (samplesIntoInterval + numSamples) % interval;
+}
+
+template < typename SampleType >
+void LFO< SampleType >::getRamp (SampleType* dest) const
+{
+    const auto* values = storage.getReadPointer (0);
+
+    if (interval == 1)
+    {
+        vecops::copy (values, dest, lastNumSamples);
+        return;
+    }
+
+    const auto invInterval = SampleType (1) / static_cast< SampleType > (interval);
+
+    auto from = blockStartValue;
+    auto to   = blockStartTarget;
+    auto pos  = blockStartOffset;
+    int  next = 0;
+
+    for (int i = 0; i < lastNumSamples;)
+    {
+        const auto count = std::min (interval - pos, lastNumSamples - i);
+        const auto step  = (to - from) * invInterval;
+        const auto start = from + step * static_cast< SampleType > (pos);
+
+        for (int s = 0; s < count; ++s)
+            dest[i + s] = start + step * static_cast< SampleType > (s);
+
+        i += count;
+        pos += count;
+
+        if (pos == interval)
+        {
+            pos  = 0;
+            from = to;
+            to   = values[next++];
+        }
+    }
 }
 
 template class LFO< float >;
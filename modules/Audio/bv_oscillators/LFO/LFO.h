@@ -3,18 +3,53 @@
 
 namespace bav::dsp
 {
+/*
+    An LFO that can run at control rate: it computes one value every N samples, and exposes either those decimated values or a linearly interpolated per-sample ramp.
+    With an interval of 1, every sample is computed by the oscillator.
+*/
 template < typename SampleType >
 class LFO : public osc::ChoosableOscillator< SampleType >
 {
 public:
     using AudioBuffer = juce::AudioBuffer< SampleType >;
 
+    void prepare (int blocksize, double samplerate);
+
+    /*
+        Sets how many samples each computed value spans.
+        If the LFO has been prepared, this re-prepares it, which reallocates its storage and resets its phase. Like prepare(), it must therefore only be called while process() can't be running.
+    */
+    void setControlRateInterval (int samplesPerValue);
+    int  getControlRateInterval() const { return interval; }
+
     void process (int numSamples);
 
+    /* The values computed by the last call to process(): one per elapsed interval. */
+    const SampleType* getControlValues() const { return storage.getReadPointer (0); }
+    int               getNumControlValues() const { return numControlValues; }
+
+    /* Writes the last processed block as a per-sample ramp between the control values. dest must hold as many samples as were last processed. */
+    void getRamp (SampleType* dest) const;
+
 private:
     void prepared (int blocksize) final;
 
     AudioBuffer storage;
+
+    int interval {1};
+    int numControlValues {0};
+    int lastNumSamples {0};
+
+    // the ramp runs from currentValue towards targetValue over each interval
+    SampleType currentValue {0}, targetValue {0};
+    int        samplesIntoInterval {0};
+    bool       primed {false};
+
+    SampleType blockStartValue {0}, blockStartTarget {0};
+    int        blockStartOffset {0};
+
+    double lastSamplerate {0.};
+    int    lastBlocksize {0};
 };
 
 }  // namespace bav::dsp
@@ -2,17 +2,16 @@
 namespace bav::dsp::osc
 {
 template < typename SampleType >
-SuperSaw< SampleType >::SuperSaw()
+SuperSaw< SampleType >::SuperSaw (int initNumVoices)
 {
-    while (saws.size() < 7)
-        saws.add (new Saw< SampleType >());
+    setNumVoices (initNumVoices);
 }
 
 template < typename SampleType >
 void SuperSaw< SampleType >::resetPhase()
 {
-    for (auto* saw : saws)
-        saw->resetPhase();
+    for (auto& group : groups)
+        std::fill (std::begin (group.phases), std::end (group.phases), SampleType (0));
 }
 
 template < typename SampleType >
@@ -21,16 +20,34 @@ void SuperSaw< SampleType >::setFrequency (SampleType frequency, SampleType samp
     lastFrequency = frequency;
     samplerate    = sampleRate;
 
-    const auto spreadSemitones = (float) totalSpreadCents * 0.01f;
-    const auto increment       = spreadSemitones / (float) saws.size();
+    const auto spreadSemitones = static_cast< SampleType > (totalSpreadCents) * SampleType (0.01);
+    const auto increment       = numVoices > 1 ? spreadSemitones / static_cast< SampleType > (numVoices - 1) : SampleType (0);
     const auto centerPitch     = math::freqToMidi (frequency);
 
-    auto lowBound = centerPitch - (spreadSemitones * 0.5f);
+    auto pitch = centerPitch - spreadSemitones * SampleType (0.5);
 
-    for (auto* saw : saws)
+    if (numVoices < 2)
+        pitch = centerPitch;
+
+    const auto totalLanes = static_cast< int > (groups.size()) * laneWidth;
+
+    for (int voice = 0; voice < totalLanes; ++voice)
     {
-        saw->setFrequency ((SampleType) math::midiToFreq (lowBound), sampleRate);
-        lowBound += increment;
+        auto&      group  = groups[static_cast< size_t > (voice / laneWidth)];
+        const auto lane   = voice % laneWidth;
+        const auto active = voice < numVoices;
+
+        // unused lanes still get a valid increment, so that their muted BLEP never divides by zero
+        const auto freq = active ? math::midiToFreq (pitch) : frequency;
+        const auto inc  = freq / sampleRate;
+
+        jassert (inc > 0 && inc < 1);
+
+        group.increments[lane]    = inc;
+        group.invIncrements[lane] = SampleType (1) / inc;
+        group.gains[lane]         = active ? SampleType (1) : SampleType (0);
+
+        pitch += increment;
     }
 }
 
@@ -48,16 +65,81 @@ int SuperSaw< SampleType >::getPitchSpreadCents() const
 }
 
 template < typename SampleType >
-SampleType SuperSaw< SampleType >::getSample()
+void SuperSaw< SampleType >::setNumVoices (int newNumVoices)
 {
-    auto sample = (SampleType) 0.;
+    jassert (newNumVoices > 0);
 
-    for (auto* saw : saws)
-        sample += saw->getSample();
+    numVoices = newNumVoices;
+    groups.resize (static_cast< size_t > ((numVoices + laneWidth - 1) / laneWidth));
 
+    setFrequency (lastFrequency, samplerate);
+}
+
+template < typename SampleType >
+int SuperSaw< SampleType >::getNumVoices() const
+{
+    return numVoices;
+}
+
+template < typename SampleType >
+SampleType SuperSaw< SampleType >::getSample()
+{
+    SampleType sample;
+    renderBlock (&sample, 1);
     return sample;
 }
 
+template < typename SampleType >
+void SuperSaw< SampleType >::getSamples (SampleType* output, int numSamples)
+{
+    renderBlock (output, numSamples);
+}
+
+template < typename SampleType >
+void SuperSaw< SampleType >::renderBlock (SampleType* output, int numSamples) noexcept
+{
+    std::fill (output, output + numSamples, SampleType (0));
+
+    for (auto& group : groups)
+        renderGroup (group, output, numSamples);
+}
+
+template < typename SampleType >
+void SuperSaw< SampleType >::renderGroup (LaneGroup& group, SampleType* output, int numSamples) noexcept
+{
+    // local copies, so that the lanes can stay in registers for the whole block
+    SampleType phases[laneWidth], increments[laneWidth], invIncrements[laneWidth], gains[laneWidth];
+
+    std::copy (std::begin (group.phases), std::end (group.phases), phases);
+    std::copy (std::begin (group.increments), std::end (group.increments), increments);
+    std::copy (std::begin (group.invIncrements), std::end (group.invIncrements), invIncrements);
+    std::copy (std::begin (group.gains), std::end (group.gains), gains);
+
+    for (int s = 0; s < numSamples; ++s)
+    {
+        SampleType lanes[laneWidth];
+
+        for (int l = 0; l < laneWidth; ++l)
+        {
+            const auto p = phases[l];
+
+            lanes[l] = (SampleType (2) * p - SampleType (1) - blep (p, increments[l], invIncrements[l])) * gains[l];
+
+            const auto next = p + increments[l];
+            phases[l]       = next - (next >= SampleType (1) ? SampleType (1) : SampleType (0));
+        }
+
+        auto sum = SampleType (0);
+
+        for (int l = 0; l < laneWidth; ++l)
+            sum += lanes[l];
+
+        output[s] += sum;
+    }
+
+    std::copy (std::begin (phases), std::end (phases), group.phases);
+}
+
 template class SuperSaw< float >;
 template class SuperSaw< double >;
 
@@ -2,11 +2,16 @@
 
 namespace bav::dsp::osc
 {
+/*
+    A stack of detuned polyBLEP saws.
+    The saws' phases and increments are stored as a structure of arrays in groups of 8 lanes, so that every saw in a group is advanced and BLEP-corrected in parallel.
+    Any number of voices up to a multiple of 8 costs the same as a full group.
+*/
 template < typename SampleType >
 class SuperSaw : public Oscillator< SampleType >
 {
 public:
-    SuperSaw();
+    SuperSaw (int numVoices = 7);
 
     void resetPhase() final;
     void setFrequency (SampleType frequency, SampleType sampleRate) final;
@@ -14,11 +19,31 @@ public:
     void setDetuneAmount (int totalPitchSpreadInCents);
     int  getPitchSpreadCents() const;
 
+    /* this allocates, so shouldn't be called from the audio thread */
+    void setNumVoices (int newNumVoices);
+    int  getNumVoices() const;
+
     SampleType getSample() final;
+    void       getSamples (SampleType* output, int numSamples) final;
+
+    void renderBlock (SampleType* output, int numSamples) noexcept;
 
 private:
-    juce::OwnedArray< Saw< SampleType > > saws;
+    static constexpr int laneWidth = 8;
+
+    struct LaneGroup
+    {
+        SampleType phases[laneWidth] {};
+        SampleType increments[laneWidth] {};
+        SampleType invIncrements[laneWidth] {};
+        SampleType gains[laneWidth] {};  // 1 for active voices, 0 for the unused lanes of the last group
+    };
+
+    void renderGroup (LaneGroup& group, SampleType* output, int numSamples) noexcept;
+
+    std::vector< LaneGroup > groups;
 
+    int numVoices {0};
     int totalSpreadCents {0};
 
     SampleType lastFrequency {440.}, samplerate {44100.};
@@ -0,0 +1,255 @@
+
+namespace bav::dsp::osc
+{
+template < typename SampleType >
+typename WavetableData< SampleType >::Ptr WavetableData< SampleType >::createFromCycle (const SampleType* cycle, int numSamples)
+{
+    return Ptr (new WavetableData (cycle, numSamples));
+}
+
+template < typename SampleType >
+typename WavetableData< SampleType >::Ptr WavetableData< SampleType >::getSaw()
+{
+    static const Ptr saw = []
+    {
+        constexpr int size = 2048;
+
+        std::vector< SampleType > cycle (size);
+
+        for (int i = 0; i < size; ++i)
+            cycle[static_cast< size_t > (i)] = SampleType (2) * static_cast< SampleType > (i) / static_cast< SampleType > (size) - SampleType (1);
+
+        return createFromCycle (cycle.data(), size);
+    }();
+
+    return saw;
+}
+
+template < typename SampleType >
+WavetableData< SampleType >::WavetableData (const SampleType* cycle, int numSamples)
+    : tableSize (numSamples)
+{
+    jassert (math::isPowerOfTwo (numSamples) && numSamples >= 8);
+
+    int order = 0;
+    while ((1 << order) < numSamples)
+        ++order;
+
+    // the highest level keeps only the fundamental
+    numLevels = order - 1;
+
+    juce::dsp::FFT fft (order);
+
+    const auto fftSize = static_cast< size_t > (numSamples) * 2;
+
+    std::vector< float > spectrum (fftSize, 0.f), level (fftSize);
+
+    for (int i = 0; i < numSamples; ++i)
+        spectrum[static_cast< size_t > (i)] = static_cast< float > (cycle[i]);
+
+    fft.performRealOnlyForwardTransform (spectrum.data());
+
+    tables.resize (static_cast< size_t > (numLevels * getStride()));
+
+    for (int l = 0; l < numLevels; ++l)
+    {
+        const auto maxHarmonic = numSamples >> (l + 2);
+
+        std::copy (spectrum.begin(), spectrum.end(), level.begin());
+
+        // zero every bin above this level's highest harmonic, including the mirrored negative frequencies
+        for (int bin = maxHarmonic + 1; bin < numSamples - maxHarmonic; ++bin)
+        {
+            level[static_cast< size_t > (bin * 2)]     = 0.f;
+            level[static_cast< size_t > (bin * 2 + 1)] = 0.f;
+        }
+
+        fft.performRealOnlyInverseTransform (level.data());
+
+        auto* table = tables.data() + l * getStride();
+
+        for (int i = -1; i < numSamples + 3; ++i)
+            table[i + 1] = static_cast< SampleType > (level[static_cast< size_t > ((i + numSamples) % numSamples)]);
+    }
+}
+
+template < typename SampleType >
+const SampleType* WavetableData< SampleType >::getTableForIncrement (SampleType increment) const noexcept
+{
+    // level 0 holds tableSize / 4 harmonics, each level above holds half as many as the one below it
+    auto limit = SampleType (2) / static_cast< SampleType > (tableSize);
+    int  level = 0;
+
+    while (increment > limit && level < numLevels - 1)
+    {
+        limit *= SampleType (2);
+        ++level;
+    }
+
+    return tables.data() + level * getStride();
+}
+
+template class WavetableData< float >;
+template class WavetableData< double >;
+
+/*--------------------------------------------------------------------------------------------*/
+
+template < WavetableInterpolation Interpolation, typename SampleType >
+static inline SampleType readWavetable (const SampleType* table, int tableSize, SampleType phase) noexcept
+{
+    const auto position = phase * static_cast< SampleType > (tableSize);
+    const auto index    = static_cast< int > (position);
+    const auto frac     = position - static_cast< SampleType > (index);
+
+    // table[index] is the sample before the read position, thanks to the leading guard sample
+    const auto* t = table + index;
+
+    if constexpr (Interpolation == LinearInterpolation)
+    {
+        return t[1] + frac * (t[2] - t[1]);
+    }
+    else
+    {
+        // Catmull-Rom
+        const auto c1 = SampleType (0.5) * (t[2] - t[0]);
+        const auto c2 = t[0] - SampleType (2.5) * t[1] + SampleType (2) * t[2] - SampleType (0.5) * t[3];
+        const auto c3 = SampleType (0.5) * (t[3] - t[0]) + SampleType (1.5) * (t[1] - t[2]);
+
+        return ((c3 * frac + c2) * frac + c1) * frac + t[1];
+    }
+}
+
+template < typename SampleType >
+Wavetable< SampleType >::Wavetable()
+    : newestTable (Data::getSaw())
+{
+    publishedTable.store (newestTable.get());
+    activeTable = newestTable.get();
+    updateCurrentTable();
+}
+
+template < typename SampleType >
+void Wavetable< SampleType >::setFrequency (SampleType frequency, SampleType sampleRate)
+{
+    OscillatorBlock< SampleType, Wavetable< SampleType > >::setFrequency (frequency, sampleRate);
+    updateCurrentTable();
+}
+
+template < typename SampleType >
+void Wavetable< SampleType >::setTable (TablePtr newTable)
+{
+    jassert (newTable != nullptr);
+
+    ++numTablesPublished;
+
+    retiredTables.push_back ({std::move (newestTable), numTablesPublished});
+    newestTable = std::move (newTable);
+
+    // the table is stored before its version, so a thread that sees the version also sees this table or a newer one
+    publishedTable.store (newestTable.get(), std::memory_order_release);
+    publishedVersion.store (numTablesPublished, std::memory_order_release);
+
+    const auto acknowledged = acknowledgedVersion.load (std::memory_order_acquire);
+
+    retiredTables.erase (std::remove_if (retiredTables.begin(), retiredTables.end(),
+                                         [acknowledged] (const RetiredTable& t)
+                                         { return t.supersededAtVersion <= acknowledged; }),
+                         retiredTables.end());
+}
+
+template < typename SampleType >
+typename Wavetable< SampleType >::TablePtr Wavetable< SampleType >::getTable() const
+{
+    return newestTable;
+}
+
+template < typename SampleType >
+void Wavetable< SampleType >::pickUpNewTable() noexcept
+{
+    const auto version = publishedVersion.load (std::memory_order_acquire);
+
+    if (version == activeVersion) return;
+
+    activeTable   = publishedTable.load (std::memory_order_acquire);
+    activeVersion = version;
+    updateCurrentTable();
+
+    acknowledgedVersion.store (version, std::memory_order_release);
+}
+
+template < typename SampleType >
+void Wavetable< SampleType >::setInterpolation (WavetableInterpolation newInterpolation) noexcept
+{
+    interpolation = newInterpolation;
+}
+
+template < typename SampleType >
+WavetableInterpolation Wavetable< SampleType >::getInterpolation() const noexcept
+{
+    return interpolation;
+}
+
+template < typename SampleType >
+void Wavetable< SampleType >::updateCurrentTable() noexcept
+{
+    currentTable = activeTable->getTableForIncrement (this->getIncrement());
+}
+
+template < typename SampleType >
+SampleType Wavetable< SampleType >::kernel (SampleType phase, SampleType) noexcept
+{
+    const auto size = activeTable->getTableSize();
+
+    if (interpolation == LinearInterpolation)
+        return readWavetable< LinearInterpolation > (currentTable, size, phase);
+
+    return readWavetable< CubicInterpolation > (currentTable, size, phase);
+}
+
+template < typename SampleType >
+SampleType Wavetable< SampleType >::renderSample() noexcept
+{
+    pickUpNewTable();
+
+    return OscillatorBlock< SampleType, Wavetable< SampleType > >::renderSample();
+}
+
+template < typename SampleType >
+void Wavetable< SampleType >::renderBlock (SampleType* output, int numSamples) noexcept
+{
+    render< false > (output, numSamples);
+}
+
+template < typename SampleType >
+void Wavetable< SampleType >::addBlock (SampleType* output, int numSamples) noexcept
+{
+    render< true > (output, numSamples);
+}
+
+template < typename SampleType >
+template < bool Accumulate >
+void Wavetable< SampleType >::render (SampleType* output, int numSamples) noexcept
+{
+    pickUpNewTable();
+
+    const auto* table = currentTable;
+    const auto  size  = activeTable->getTableSize();
+
+    if (interpolation == LinearInterpolation)
+    {
+        this->template process< Accumulate > (output, numSamples, [table, size] (SampleType p, SampleType)
+                                              { return readWavetable< LinearInterpolation > (table, size, p); });
+    }
+    else
+    {
+        this->template process< Accumulate > (output, numSamples, [table, size] (SampleType p, SampleType)
+                                              { return readWavetable< CubicInterpolation > (table, size, p); });
+    }
+}
+
+template struct OscillatorBlock< float, Wavetable< float > >;
+template struct OscillatorBlock< double, Wavetable< double > >;
+template struct Wavetable< float >;
+template struct Wavetable< double >;
+
+}  // namespace bav::dsp::osc
@@ -0,0 +1,107 @@
+#pragma once
+
+namespace bav::dsp::osc
+{
+/*
+    Band-limited mipmaps of one single-cycle waveform: one table per octave, each holding only the harmonics that stay below Nyquist for that octave's highest fundamental.
+    The tables are generated once with an FFT and never change afterwards, so one instance can be shared read-only by any number of oscillators and voices.
+*/
+template < typename SampleType >
+class WavetableData
+{
+public:
+    using Ptr = std::shared_ptr< const WavetableData >;
+
+    /* Creates mipmaps from one cycle of a waveform. The number of samples must be a power of two. */
+    static Ptr createFromCycle (const SampleType* cycle, int numSamples);
+
+    /* Returns the shared mipmaps for a band-limited sawtooth, generated on first use. */
+    static Ptr getSaw();
+
+    int getTableSize() const noexcept { return tableSize; }
+    int getNumLevels() const noexcept { return numLevels; }
+
+    /* Returns the table to play at the given phase increment.
+       The returned pointer points at a guard sample; the cycle itself starts at index 1, and is followed by three more guard samples. */
+    const SampleType* getTableForIncrement (SampleType increment) const noexcept;
+
+private:
+    WavetableData (const SampleType* cycle, int numSamples);
+
+    int getStride() const noexcept { return tableSize + 4; }
+
+    int tableSize, numLevels;
+
+    std::vector< SampleType > tables;
+};
+
+/*--------------------------------------------------------------------------------------------*/
+
+enum WavetableInterpolation
+{
+    LinearInterpolation,
+    CubicInterpolation
+};
+
+/*--------------------------------------------------------------------------------------------*/
+
+/*
+    Oscillator that plays a band-limited wavetable.
+    The mipmap level is chosen when the frequency changes, so any timbre costs the same as the analytic waveforms.
+*/
+template < typename SampleType >
+struct Wavetable : public OscillatorBlock< SampleType, Wavetable< SampleType > >
+{
+    using TablePtr = typename WavetableData< SampleType >::Ptr;
+
+    Wavetable();
+
+    void setFrequency (SampleType frequency, SampleType sampleRate) final;
+
+    /* Call these from the message thread. The new table is published without locking, and the audio thread switches to it at the start of its next block; the old table is kept alive until the audio thread has moved on from it. */
+    void     setTable (TablePtr newTable);
+    TablePtr getTable() const;
+
+    void                   setInterpolation (WavetableInterpolation newInterpolation) noexcept;
+    WavetableInterpolation getInterpolation() const noexcept;
+
+    SampleType kernel (SampleType phase, SampleType increment) noexcept;
+    SampleType renderSample() noexcept;
+    void       renderBlock (SampleType* output, int numSamples) noexcept;
+    void       addBlock (SampleType* output, int numSamples) noexcept;
+
+private:
+    using Data = WavetableData< SampleType >;
+
+    template < bool Accumulate >
+    void render (SampleType* output, int numSamples) noexcept;
+
+    // audio thread: switches to the newest table published by setTable()
+    void pickUpNewTable() noexcept;
+
+    void updateCurrentTable() noexcept;
+
+    struct RetiredTable
+    {
+        TablePtr table;
+        uint32_t supersededAtVersion;
+    };
+
+    // message thread
+    TablePtr                    newestTable;
+    std::vector< RetiredTable > retiredTables;
+    uint32_t                    numTablesPublished {0};
+
+    // handoff: the audio thread acknowledges each version it has picked up, after which any table superseded at or before that version can be freed
+    std::atomic< const Data* > publishedTable {nullptr};
+    std::atomic< uint32_t >    publishedVersion {0}, acknowledgedVersion {0};
+
+    // audio thread
+    const Data*       activeTable {nullptr};
+    const SampleType* currentTable {nullptr};
+    uint32_t          activeVersion {0};
+
+    WavetableInterpolation interpolation {CubicInterpolation};
+};
+
+}  // namespace bav::dsp::osc
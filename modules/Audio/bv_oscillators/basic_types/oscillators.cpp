@@ -10,7 +10,7 @@ void Phase< SampleType >::resetPhase() noexcept
 template < typename SampleType >
 void Phase< SampleType >::setFrequency (SampleType frequency, SampleType sampleRate)
 {
-    jassert (sampleRate > 0 && frequency > 0);
+    jassert (sampleRate > 0 && frequency > 0 && frequency < sampleRate);
     increment = frequency / sampleRate;
 }
 
@@ -19,13 +19,26 @@ SampleType Phase< SampleType >::next (SampleType wrapLimit) noexcept
 {
     const auto p = phase;
 
+    // the increment is always less than a full cycle, so a single branch-free subtraction is enough
     phase += increment;
-    while (phase >= wrapLimit)
-        phase -= wrapLimit;
+    phase -= phase >= wrapLimit ? wrapLimit : SampleType (0);
 
     return p;
 }
 
+template < typename SampleType >
+SampleType Phase< SampleType >::getPhase() const noexcept
+{
+    return phase;
+}
+
+template < typename SampleType >
+void Phase< SampleType >::advance (int numSamples) noexcept
+{
+    const auto end = phase + increment * static_cast< SampleType > (numSamples);
+    phase          = end - static_cast< SampleType > (static_cast< int > (end));
+}
+
 template < typename SampleType >
 SampleType Phase< SampleType >::getIncrement() const
 {
@@ -37,24 +50,23 @@ template struct Phase< double >;
 
 /*--------------------------------------------------------------------------------------------*/
 
+/* polyBLEP residual, written with selects instead of branches so that it vectorizes */
 template < typename SampleType >
-static inline SampleType blep (SampleType phase, SampleType increment) noexcept
+static inline SampleType blep (SampleType phase, SampleType increment, SampleType invIncrement) noexcept
 {
     static constexpr SampleType one = 1;
 
-    if (phase < increment)
-    {
-        auto p = phase / increment;
-        return (2 - p) * p - one;
-    }
+    const auto start = phase * invIncrement;
+    const auto end   = (phase - one) * invIncrement;
 
-    if (phase > one - increment)
-    {
-        auto p = (phase - one) / increment;
-        return (p + 2) * p + one;
-    }
+    return (phase < increment ? (2 - start) * start - one : SampleType (0))
+         + (phase > one - increment ? (end + 2) * end + one : SampleType (0));
+}
 
-    return SampleType (0);
+template < typename SampleType >
+static inline SampleType blep (SampleType phase, SampleType increment) noexcept
+{
+    return blep (phase, increment, SampleType (1) / increment);
 }
 
 template float  blep (float phase, float increment) noexcept;
@@ -74,131 +86,227 @@ template struct Oscillator< double >;
 
 /*--------------------------------------------------------------------------------------------*/
 
-template < typename SampleType >
-Sine< SampleType >::Sine()
+template < typename SampleType, class Derived >
+void OscillatorBlock< SampleType, Derived >::resetPhase()
 {
     phase.resetPhase();
 }
 
-template < typename SampleType >
-void Sine< SampleType >::resetPhase()
+template < typename SampleType, class Derived >
+void OscillatorBlock< SampleType, Derived >::setFrequency (SampleType frequency, SampleType sampleRate)
 {
-    phase.resetPhase();
+    phase.setFrequency (frequency, sampleRate);
 }
 
-template < typename SampleType >
-void Sine< SampleType >::setFrequency (SampleType frequency, SampleType sampleRate)
+template < typename SampleType, class Derived >
+SampleType OscillatorBlock< SampleType, Derived >::getSample()
 {
-    phase.setFrequency (twoPi * frequency, sampleRate);
+    return static_cast< Derived& > (*this).renderSample();
 }
 
-template < typename SampleType >
-SampleType Sine< SampleType >::getSample()
+template < typename SampleType, class Derived >
+void OscillatorBlock< SampleType, Derived >::getSamples (SampleType* output, int numSamples)
 {
-    return std::sin (phase.next (twoPi));
+    static_cast< Derived& > (*this).renderBlock (output, numSamples);
 }
 
-template struct Sine< float >;
-template struct Sine< double >;
-
-/*--------------------------------------------------------------------------------------------*/
-
-template < typename SampleType >
-Saw< SampleType >::Saw()
+template < typename SampleType, class Derived >
+SampleType OscillatorBlock< SampleType, Derived >::getIncrement() const
 {
-    phase.resetPhase();
+    return phase.getIncrement();
 }
 
-template < typename SampleType >
-void Saw< SampleType >::resetPhase()
+template < typename SampleType, class Derived >
+SampleType OscillatorBlock< SampleType, Derived >::renderSample() noexcept
 {
-    phase.resetPhase();
+    const auto increment = phase.getIncrement();
+    return static_cast< Derived& > (*this).kernel (phase.next (1), increment);
 }
 
-template < typename SampleType >
-void Saw< SampleType >::setFrequency (SampleType frequency, SampleType sampleRate)
+template < typename SampleType, class Derived >
+void OscillatorBlock< SampleType, Derived >::renderBlock (SampleType* output, int numSamples) noexcept
 {
-    phase.setFrequency (frequency, sampleRate);
+    auto& derived = static_cast< Derived& > (*this);
+
+    process< false > (output, numSamples,
+                      [&derived] (SampleType p, SampleType increment)
+                      { return derived.kernel (p, increment); });
 }
 
-template < typename SampleType >
-SampleType Saw< SampleType >::getSample()
+template < typename SampleType, class Derived >
+void OscillatorBlock< SampleType, Derived >::addBlock (SampleType* output, int numSamples) noexcept
 {
-    auto p = phase.next (1);
-    return SampleType (2.0) * p - SampleType (1.0) - blep (p, phase.getIncrement());
+    auto& derived = static_cast< Derived& > (*this);
+
+    process< true > (output, numSamples,
+                     [&derived] (SampleType p, SampleType increment)
+                     { return derived.kernel (p, increment); });
 }
 
-template struct Saw< float >;
-template struct Saw< double >;
+template < typename SampleType, class Derived >
+template < bool Accumulate, typename Kernel >
+void OscillatorBlock< SampleType, Derived >::process (SampleType* output, int numSamples, Kernel&& kernel) noexcept
+{
+    const auto start     = phase.getPhase();
+    const auto increment = phase.getIncrement();
+
+    jassert (increment >= 0 && increment < 1);
+
+    // each phase is computed from the starting phase rather than accumulated, so that the loop carries no dependency and can vectorize
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto p = start + increment * static_cast< SampleType > (i);
+        p -= static_cast< SampleType > (static_cast< int > (p));
+
+        if constexpr (Accumulate)
+            output[i] += kernel (p, increment);
+        else
+            output[i] = kernel (p, increment);
+    }
+
+    phase.advance (numSamples);
+}
 
 /*--------------------------------------------------------------------------------------------*/
 
+/* Returns sin (2 * pi * phase) for a normalized phase in the range [0, 1).
+   The phase is folded into [-0.25, 0.25], where an odd minimax polynomial approximates one quarter of the cycle. */
+template < SineQuality Quality, typename SampleType >
+static inline SampleType sineFromPhase (SampleType phase) noexcept
+{
+    if constexpr (Quality == ExactSine)
+    {
+        return static_cast< SampleType > (std::sin (phase * static_cast< SampleType > (3.141592653589793238 * 2.0)));
+    }
+    else
+    {
+        auto u = phase - SampleType (0.25);
+        u -= u > SampleType (0.5) ? SampleType (1) : SampleType (0);
+
+        const auto w  = SampleType (0.25) - std::abs (u);
+        const auto w2 = w * w;
+
+        if constexpr (Quality == FastSine)
+        {
+            return w * (SampleType (6.2812800766225845) + w2 * (SampleType (-41.095242687125875) + w2 * SampleType (73.58551473465486)));
+        }
+        else
+        {
+            return w * (SampleType (6.283185160089479) + w2 * (SampleType (-41.34165503141651) + w2 * (SampleType (81.60100407327357) + w2 * (SampleType (-76.54978229382905) + w2 * SampleType (39.53670606730218)))));
+        }
+    }
+}
+
 template < typename SampleType >
-Square< SampleType >::Square()
+void Sine< SampleType >::setQuality (SineQuality newQuality) noexcept
 {
-    phase.resetPhase();
+    quality = newQuality;
 }
 
 template < typename SampleType >
-void Square< SampleType >::resetPhase()
+SineQuality Sine< SampleType >::getQuality() const noexcept
 {
-    phase.resetPhase();
+    return quality;
 }
 
 template < typename SampleType >
-void Square< SampleType >::setFrequency (SampleType frequency, SampleType sampleRate)
+SampleType Sine< SampleType >::kernel (SampleType phase, SampleType) noexcept
 {
-    phase.setFrequency (frequency, sampleRate);
+    switch (quality)
+    {
+        case (FastSine) : return sineFromPhase< FastSine > (phase);
+        case (AccurateSine) : return sineFromPhase< AccurateSine > (phase);
+        case (ExactSine) : return sineFromPhase< ExactSine > (phase);
+    }
+
+    return sineFromPhase< ExactSine > (phase);
 }
 
 template < typename SampleType >
-SampleType Square< SampleType >::getSample()
+void Sine< SampleType >::renderBlock (SampleType* output, int numSamples) noexcept
 {
-    const auto inc = phase.getIncrement();
-    const auto p   = phase.next (1);
+    render< false > (output, numSamples);
+}
 
-    return (p < SampleType (0.5) ? SampleType (-1) : SampleType (1))
-         - blep (p, inc)
-         + blep (std::fmod (p + SampleType (0.5), SampleType (1)), inc);
+template < typename SampleType >
+void Sine< SampleType >::addBlock (SampleType* output, int numSamples) noexcept
+{
+    render< true > (output, numSamples);
 }
 
+/* the quality switch is hoisted out of the loop, so that each kernel is inlined into its own loop */
 template < typename SampleType >
-SampleType Square< SampleType >::getIncrement() const
+template < bool Accumulate >
+void Sine< SampleType >::render (SampleType* output, int numSamples) noexcept
 {
-    return phase.getIncrement();
+    switch (quality)
+    {
+        case (FastSine) :
+            return this->template process< Accumulate > (output, numSamples, [] (SampleType p, SampleType)
+                                                         { return sineFromPhase< FastSine > (p); });
+        case (AccurateSine) :
+            return this->template process< Accumulate > (output, numSamples, [] (SampleType p, SampleType)
+                                                         { return sineFromPhase< AccurateSine > (p); });
+        case (ExactSine) :
+            return this->template process< Accumulate > (output, numSamples, [] (SampleType p, SampleType)
+                                                         { return sineFromPhase< ExactSine > (p); });
+    }
 }
 
-template struct Square< float >;
-template struct Square< double >;
+template struct OscillatorBlock< float, Sine< float > >;
+template struct OscillatorBlock< double, Sine< double > >;
+template struct Sine< float >;
+template struct Sine< double >;
 
 /*--------------------------------------------------------------------------------------------*/
 
 template < typename SampleType >
-Triangle< SampleType >::Triangle()
+SampleType Saw< SampleType >::kernel (SampleType phase, SampleType increment) noexcept
 {
-    resetPhase();
+    return SampleType (2.0) * phase - SampleType (1.0) - blep (phase, increment);
 }
 
+template struct OscillatorBlock< float, Saw< float > >;
+template struct OscillatorBlock< double, Saw< double > >;
+template struct Saw< float >;
+template struct Saw< double >;
+
+/*--------------------------------------------------------------------------------------------*/
+
 template < typename SampleType >
-void Triangle< SampleType >::resetPhase()
+SampleType Square< SampleType >::kernel (SampleType phase, SampleType increment) noexcept
 {
-    square.resetPhase();
-    sum = static_cast< SampleType > (1);
+    auto halfCycle = phase + SampleType (0.5);
+    halfCycle -= halfCycle >= SampleType (1) ? SampleType (1) : SampleType (0);
+
+    return (phase < SampleType (0.5) ? SampleType (-1) : SampleType (1))
+         - blep (phase, increment)
+         + blep (halfCycle, increment);
 }
 
+template struct OscillatorBlock< float, Square< float > >;
+template struct OscillatorBlock< double, Square< double > >;
+template struct Square< float >;
+template struct Square< double >;
+
+/*--------------------------------------------------------------------------------------------*/
+
 template < typename SampleType >
-void Triangle< SampleType >::setFrequency (SampleType frequency, SampleType sampleRate)
+void Triangle< SampleType >::resetPhase()
 {
-    square.setFrequency (frequency, sampleRate);
+    OscillatorBlock< SampleType, Triangle< SampleType > >::resetPhase();
+    sum = static_cast< SampleType > (1);
 }
 
 template < typename SampleType >
-SampleType Triangle< SampleType >::getSample()
+SampleType Triangle< SampleType >::kernel (SampleType phase, SampleType increment) noexcept
 {
-    sum += SampleType (4) * square.getIncrement() * square.getSample();
+    sum += SampleType (4) * increment * Square< SampleType >::kernel (phase, increment);
     return sum;
 }
 
+template struct OscillatorBlock< float, Triangle< float > >;
+template struct OscillatorBlock< double, Triangle< double > >;
 template struct Triangle< float >;
 template struct Triangle< double >;
 
@@ -13,6 +13,12 @@ struct Phase
     SampleType getIncrement() const;
     SampleType next (SampleType wrapLimit) noexcept;
 
+    /* Returns the current phase, in the range [0, 1) */
+    SampleType getPhase() const noexcept;
+
+    /* Advances the phase by numSamples increments, wrapping it to the range [0, 1) */
+    void advance (int numSamples) noexcept;
+
 private:
     SampleType phase = 0, increment = 0;
 };
@@ -28,70 +34,102 @@ struct Oscillator
     virtual void       setFrequency (SampleType frequency, SampleType sampleRate) = 0;
     virtual SampleType getSample()                                                = 0;
 
-    void getSamples (SampleType* output, int numSamples);
+    virtual void getSamples (SampleType* output, int numSamples);
 };
 
 /*--------------------------------------------------------------------------------------------*/
 
-template < typename SampleType >
-struct Sine : public Oscillator< SampleType >
+/*
+    Compile-time dispatched block rendering for oscillators driven by a single normalized phase.
+    Derived must provide a kernel (SampleType phase, SampleType increment) function that returns one output sample; renderBlock() and addBlock() inline it into one tight loop over the whole buffer.
+    Derived classes may also hide renderSample(), renderBlock() and addBlock() to customise rendering.
+    The virtual Oscillator interface is implemented as a thin adapter over the block API.
+*/
+template < typename SampleType, class Derived >
+struct OscillatorBlock : public Oscillator< SampleType >
 {
-    Sine();
-
-    void       resetPhase() final;
-    void       setFrequency (SampleType frequency, SampleType sampleRate) final;
+    void       resetPhase() override;
+    void       setFrequency (SampleType frequency, SampleType sampleRate) override;
     SampleType getSample() final;
+    void       getSamples (SampleType* output, int numSamples) final;
 
-private:
-    Phase< SampleType >   phase;
-    static constexpr auto twoPi = static_cast< SampleType > (3.141592653589793238 * 2.0);
+    SampleType getIncrement() const;
+
+    SampleType renderSample() noexcept;
+
+    /* writes numSamples into output */
+    void renderBlock (SampleType* output, int numSamples) noexcept;
+
+    /* adds numSamples onto the existing contents of output */
+    void addBlock (SampleType* output, int numSamples) noexcept;
+
+protected:
+    template < bool Accumulate, typename Kernel >
+    void process (SampleType* output, int numSamples, Kernel&& kernel) noexcept;
+
+    Phase< SampleType > phase;
+};
+
+/*--------------------------------------------------------------------------------------------*/
+
+/* Selects the kernel used to compute sine waves.
+   FastSine is a 5th-order minimax polynomial (max error ~7e-5, roughly -83 dB),
+   AccurateSine is a 9th-order minimax polynomial (max error ~3e-9, below float resolution),
+   and ExactSine calls std::sin. */
+enum SineQuality
+{
+    FastSine,
+    AccurateSine,
+    ExactSine
 };
 
 /*--------------------------------------------------------------------------------------------*/
 
 template < typename SampleType >
-struct Saw : public Oscillator< SampleType >
+struct Sine : public OscillatorBlock< SampleType, Sine< SampleType > >
 {
-    Saw();
+    void        setQuality (SineQuality newQuality) noexcept;
+    SineQuality getQuality() const noexcept;
 
-    void       resetPhase();
-    void       setFrequency (SampleType frequency, SampleType sampleRate) final;
-    SampleType getSample() final;
+    SampleType kernel (SampleType phase, SampleType increment) noexcept;
+    void       renderBlock (SampleType* output, int numSamples) noexcept;
+    void       addBlock (SampleType* output, int numSamples) noexcept;
 
 private:
-    Phase< SampleType > phase;
+    template < bool Accumulate >
+    void render (SampleType* output, int numSamples) noexcept;
+
+    SineQuality quality {AccurateSine};
 };
 
 /*--------------------------------------------------------------------------------------------*/
 
 template < typename SampleType >
-struct Square : public Oscillator< SampleType >
+struct Saw : public OscillatorBlock< SampleType, Saw< SampleType > >
 {
-    Square();
+    static SampleType kernel (SampleType phase, SampleType increment) noexcept;
+};
 
-    void       resetPhase() final;
-    void       setFrequency (SampleType frequency, SampleType sampleRate) final;
-    SampleType getSample() final;
-    SampleType getIncrement() const;
+/*--------------------------------------------------------------------------------------------*/
 
-private:
-    Phase< SampleType > phase;
+template < typename SampleType >
+struct Square : public OscillatorBlock< SampleType, Square< SampleType > >
+{
+    static SampleType kernel (SampleType phase, SampleType increment) noexcept;
 };
 
 /*--------------------------------------------------------------------------------------------*/
 
 template < typename SampleType >
-struct Triangle : public Oscillator< SampleType >
+struct Triangle : public OscillatorBlock< SampleType, Triangle< SampleType > >
 {
-    Triangle();
+    void resetPhase() final;
 
-    void       resetPhase() final;
-    void       setFrequency (SampleType frequency, SampleType sampleRate) final;
-    SampleType getSample() final;
+    /* integrates the band-limited square kernel */
+    SampleType kernel (SampleType phase, SampleType increment) noexcept;
 
 private:
-    Square< SampleType > square;
-    SampleType           sum = 1;
+    SampleType sum = 1;
 };
 
 }  // namespace bav::dsp::osc
@@ -3,6 +3,7 @@
 
 
 #include "basic_types/oscillators.cpp"
+#include "Wavetable/Wavetable.cpp"
 
 #include "SuperSaw/SuperSaw.cpp"
 
@@ -17,6 +17,7 @@ END_JUCE_MODULE_DECLARATION
 
 
 #include "basic_types/oscillators.h"
+#include "Wavetable/Wavetable.h"
 #include "SuperSaw/SuperSaw.h"
 
 #include "choosable/ChoosableOscillator.h"
@@ -3,76 +3,144 @@ namespace bav::dsp::osc
 template < typename SampleType >
 ChoosableOscillator< SampleType >::ChoosableOscillator()
 {
-    setFrequency (440.f);
+    engines[0] = createEngine (type);
 }
 
 template < typename SampleType >
 void ChoosableOscillator< SampleType >::setOscType (OscType newType)
 {
+    freeRetiredEngine();
+
+    if (newType == type) return;
+
+    // take back the standby slot: cancel a switch the audio thread hasn't started yet, or wait out one it's in the middle of
+    for (auto state = switchState.load (std::memory_order_acquire);
+         state != Idle;
+         state = switchState.load (std::memory_order_acquire))
+    {
+        if (state == Pending && switchState.compare_exchange_strong (state, Idle, std::memory_order_acq_rel))
+            break;
+
+        juce::Thread::yield();
+    }
+
+    // any engine left in the standby slot is destroyed here, off the audio thread
+    engines[1 - activeSlot.load (std::memory_order_acquire)] = createEngine (newType);
+
     type = newType;
+
+    switchState.store (Pending, std::memory_order_release);
+}
+
+template < typename SampleType >
+void ChoosableOscillator< SampleType >::freeRetiredEngine()
+{
+    // only the message thread moves the state away from Idle, so once it is Idle the audio thread won't touch the standby slot
+    if (switchState.load (std::memory_order_acquire) == Idle)
+        engines[1 - activeSlot.load (std::memory_order_acquire)].reset();
+}
+
+template < typename SampleType >
+std::unique_ptr< OscEngineBase< SampleType > > ChoosableOscillator< SampleType >::createEngine (OscType oscType) const
+{
+    std::unique_ptr< Engine > engine;
+
+    switch (oscType)
+    {
+        case (SineOsc) : engine = std::make_unique< OscEngine< SampleType, Sine > >(); break;
+        case (SawOsc) : engine = std::make_unique< OscEngine< SampleType, Saw > >(); break;
+        case (SquareOsc) : engine = std::make_unique< OscEngine< SampleType, Square > >(); break;
+        case (TriangleOsc) : engine = std::make_unique< OscEngine< SampleType, Triangle > >(); break;
+        case (SuperSawOsc) : engine = std::make_unique< OscEngine< SampleType, SuperSaw > >(); break;
+        case (WavetableOsc) : engine = std::make_unique< OscEngine< SampleType, Wavetable > >(); break;
+    }
+
+    jassert (engine != nullptr);
+
+    engine->setFrequency (freq.load());
+    engine->setDetuneAmount (detuneCents.load());
+    engine->setSineQuality (static_cast< SineQuality > (sineQuality.load()));
+
+    if (wavetableData != nullptr)
+        engine->setWavetable (wavetableData);
+
+    if (lastSamplerate > 0. && lastBlocksize > 0)
+        engine->prepare (lastSamplerate, lastBlocksize);
+
+    return engine;
 }
 
 template < typename SampleType >
 void ChoosableOscillator< SampleType >::process (AudioBuffer& output)
 {
-    switch (type)
+    auto expected = static_cast< int > (Pending);
+
+    if (! switchState.compare_exchange_strong (expected, Switching, std::memory_order_acquire))
+    {
+        renderEngine (*engines[activeSlot.load (std::memory_order_relaxed)], output, false);
+        return;
+    }
+
+    const auto oldSlot    = activeSlot.load (std::memory_order_relaxed);
+    const auto newSlot    = 1 - oldSlot;
+    const auto numSamples = output.getNumSamples();
+
+    jassert (numSamples <= fadeBuffer.getNumSamples());
+
+    AudioBuffer incoming {fadeBuffer.getArrayOfWritePointers(), 1, numSamples};
+
+    // the outgoing engine fades out as it becomes bypassed, and the new one fades in on its first unbypassed block
+    renderEngine (*engines[oldSlot], output, true);
+    renderEngine (*engines[newSlot], incoming, false);
+
+    output.addFrom (0, 0, incoming, 0, 0, numSamples);
+
+    activeSlot.store (newSlot, std::memory_order_relaxed);
+    switchState.store (Idle, std::memory_order_release);
+}
+
+template < typename SampleType >
+void ChoosableOscillator< SampleType >::renderEngine (Engine& engine, AudioBuffer& output, bool isBypassed)
+{
+    if (const auto f = freq.load (std::memory_order_relaxed); f != engine.getFrequency())
+        engine.setFrequency (f);
+
+    if (const auto cents = detuneCents.load (std::memory_order_relaxed); cents != engine.getDetuneAmount())
+        engine.setDetuneAmount (cents);
+
+    if (const auto quality = static_cast< SineQuality > (sineQuality.load (std::memory_order_relaxed)); quality != engine.getSineQuality())
+        engine.setSineQuality (quality);
+
+    engine.process (output, isBypassed);
+}
+
+template < typename SampleType >
+void ChoosableOscillator< SampleType >::startWithoutFade()
+{
+    auto expected = static_cast< int > (Pending);
+
+    if (switchState.compare_exchange_strong (expected, Switching, std::memory_order_acquire))
     {
-        case (SineOsc) :
-        {
-            sine.process (output, false);
-            saw.process (output, true);
-            square.process (output, true);
-            triangle.process (output, true);
-            superSaw.process (output, true);
-            return;
-        }
-        case (SawOsc) :
-        {
-            sine.process (output, true);
-            saw.process (output, false);
-            square.process (output, true);
-            triangle.process (output, true);
-            superSaw.process (output, true);
-            return;
-        }
-        case (SquareOsc) :
-        {
-            sine.process (output, true);
-            saw.process (output, true);
-            square.process (output, false);
-            triangle.process (output, true);
-            superSaw.process (output, true);
-            return;
-        }
-        case (TriangleOsc) :
-        {
-            sine.process (output, true);
-            saw.process (output, true);
-            square.process (output, true);
-            triangle.process (output, false);
-            superSaw.process (output, true);
-            return;
-        }
-        case (SuperSawOsc) :
-        {
-            sine.process (output, true);
-            saw.process (output, true);
-            square.process (output, true);
-            triangle.process (output, true);
-            superSaw.process (output, false);
-            return;
-        }
+        activeSlot.store (1 - activeSlot.load (std::memory_order_relaxed), std::memory_order_relaxed);
+        switchState.store (Idle, std::memory_order_release);
     }
+
+    engines[activeSlot.load (std::memory_order_relaxed)]->skipNextFadeIn();
 }
 
 template < typename SampleType >
 void ChoosableOscillator< SampleType >::prepare (int blocksize, double samplerate)
 {
-    sine.prepare (samplerate, blocksize);
-    saw.prepare (samplerate, blocksize);
-    square.prepare (samplerate, blocksize);
-    triangle.prepare (samplerate, blocksize);
-    superSaw.prepare (samplerate, blocksize);
+    lastSamplerate = samplerate;
+    lastBlocksize  = blocksize;
+
+    freeRetiredEngine();
+
+    for (auto& engine : engines)
+        if (engine != nullptr)
+            engine->prepare (samplerate, blocksize);
+
+    fadeBuffer.setSize (1, blocksize, true, true, true);
 
     prepared (blocksize);
 }
@@ -85,19 +153,35 @@ void ChoosableOscillator< SampleType >::prepared (int)
 template < typename SampleType >
 void ChoosableOscillator< SampleType >::setFrequency (float freqHz)
 {
-    sine.setFrequency (freqHz);
-    saw.setFrequency (freqHz);
-    square.setFrequency (freqHz);
-    triangle.setFrequency (freqHz);
-    superSaw.setFrequency (freqHz);
-
-    freq = freqHz;
+    // applied by the audio thread to the engines it renders
+    freq.store (freqHz);
 }
 
 template < typename SampleType >
 void ChoosableOscillator< SampleType >::setDetuneAmount (int pitchSpreadCents)
 {
-    superSaw->setDetuneAmount (pitchSpreadCents);
+    // applied by the audio thread to the engines it renders
+    detuneCents.store (pitchSpreadCents);
+}
+
+template < typename SampleType >
+void ChoosableOscillator< SampleType >::setSineQuality (SineQuality quality)
+{
+    // applied by the audio thread to the engines it renders
+    sineQuality.store (quality);
+}
+
+template < typename SampleType >
+void ChoosableOscillator< SampleType >::setWavetable (typename WavetableData< SampleType >::Ptr table)
+{
+    freeRetiredEngine();
+
+    wavetableData = std::move (table);
+
+    // the wavetable oscillator publishes the table to the audio thread itself, and keeps the old one alive until the audio thread has let go of it
+    for (auto& engine : engines)
+        if (engine != nullptr)
+            engine->setWavetable (wavetableData);
 }
 
 template class ChoosableOscillator< float >;
@@ -11,9 +11,15 @@ enum OscType
     SawOsc,
     SquareOsc,
     TriangleOsc,
-    SuperSawOsc
+    SuperSawOsc,
+    WavetableOsc
 };
 
+/*
+    An oscillator whose waveform can be changed at runtime.
+    Only the engine for the current OscType exists and is prepared. Changing the type creates and prepares the new engine in a standby slot, and the audio thread then crossfades to it over its next block.
+    The outgoing engine stays in the standby slot until the message thread frees it, which setOscType(), setWavetable(), prepare() and freeRetiredEngine() all do.
+*/
 template < typename SampleType >
 class ChoosableOscillator
 {
@@ -21,31 +27,69 @@ public:
     using AudioBuffer = juce::AudioBuffer< SampleType >;
 
     ChoosableOscillator();
+    virtual ~ChoosableOscillator() = default;
 
+    /* This allocates and prepares the new engine, so call it from the message thread. */
     void    setOscType (OscType newType);
     OscType getOscType() const { return type; }
 
+    /* Frees the engine that a finished type change left behind, if there is one. Call it from the message thread, e.g. from a timer. */
+    void freeRetiredEngine();
+
     void  setFrequency (float freqHz);
-    float getFrequency() const { return freq; }
+    float getFrequency() const { return freq.load(); }
 
     void process (AudioBuffer& output);
 
     void prepare (int blocksize, double samplerate);
 
-    /* only relevant to super saw mode */
+    /* only relevant to super saw mode; applied by the audio thread at its next block */
     void setDetuneAmount (int pitchSpreadCents);
 
+    /* only relevant to sine mode; applied by the audio thread at its next block */
+    void setSineQuality (SineQuality quality);
+
+    /* only relevant to wavetable mode. Call this from the message thread; the audio thread switches to the new table at its next block. */
+    void setWavetable (typename WavetableData< SampleType >::Ptr table);
+
+protected:
+    /* Makes the next block start at full level: a pending type change is completed without a crossfade, and the engine's first-block fade-in is skipped.
+       This is for the first block of a control signal, when there's no earlier output to fade from. Call it on the audio thread. */
+    void startWithoutFade();
+
 private:
+    using Engine = OscEngineBase< SampleType >;
+
     virtual void prepared (int blocksize);
 
-    OscType type {SineOsc};
-    float   freq {440.f};
+    std::unique_ptr< Engine > createEngine (OscType oscType) const;
+
+    void renderEngine (Engine& engine, AudioBuffer& output, bool isBypassed);
+
+    enum SwitchState
+    {
+        Idle,
+        Pending,   // a new engine is waiting in the standby slot
+        Switching  // the audio thread is crossfading to the standby slot
+    };
+
+    OscType              type {SineOsc};
+    std::atomic< float > freq {440.f};
+
+    // written by the message thread, and applied by the audio thread to the engines it renders
+    std::atomic< int > detuneCents {0};
+    std::atomic< int > sineQuality {AccurateSine};
+
+    typename WavetableData< SampleType >::Ptr wavetableData;
+
+    std::unique_ptr< Engine > engines[2];
+    std::atomic< int >        activeSlot {0};
+    std::atomic< int >        switchState {Idle};
+
+    AudioBuffer fadeBuffer;
 
-    OscEngine< SampleType, Sine >     sine;
-    OscEngine< SampleType, Saw >      saw;
-    OscEngine< SampleType, Square >   square;
-    OscEngine< SampleType, Triangle > triangle;
-    OscEngine< SampleType, SuperSaw > superSaw;
+    double lastSamplerate {0.};
+    int    lastBlocksize {0};
 };
 
 }  // namespace bav::dsp::osc
@@ -16,7 +16,61 @@ template < typename SampleType, template < typename T > class OscType >
 void OscEngine< SampleType, OscType >::setFrequency (float freqHz)
 {
     frequency = freqHz;
-    osc.setFrequency (frequency, (SampleType) this->getSamplerate());
+
+    // before the engine is prepared, the frequency is applied in prepared()
+    if (const auto samplerate = this->getSamplerate(); samplerate > 0.)
+        osc.setFrequency (frequency, (SampleType) samplerate);
+}
+
+template < typename SampleType, template < typename T > class OscType >
+float OscEngine< SampleType, OscType >::getFrequency() const
+{
+    return frequency;
+}
+
+template < typename SampleType, template < typename T > class OscType >
+void OscEngine< SampleType, OscType >::setDetuneAmount (int pitchSpreadCents)
+{
+    if constexpr (std::is_same_v< OscType< SampleType >, SuperSaw< SampleType > >)
+        osc.setDetuneAmount (pitchSpreadCents);
+    else
+        juce::ignoreUnused (pitchSpreadCents);
+}
+
+template < typename SampleType, template < typename T > class OscType >
+int OscEngine< SampleType, OscType >::getDetuneAmount() const
+{
+    if constexpr (std::is_same_v< OscType< SampleType >, SuperSaw< SampleType > >)
+        return osc.getPitchSpreadCents();
+    else
+        return 0;
+}
+
+template < typename SampleType, template < typename T > class OscType >
+void OscEngine< SampleType, OscType >::setSineQuality (SineQuality quality)
+{
+    if constexpr (std::is_same_v< OscType< SampleType >, Sine< SampleType > >)
+        osc.setQuality (quality);
+    else
+        juce::ignoreUnused (quality);
+}
+
+template < typename SampleType, template < typename T > class OscType >
+SineQuality OscEngine< SampleType, OscType >::getSineQuality() const
+{
+    if constexpr (std::is_same_v< OscType< SampleType >, Sine< SampleType > >)
+        return osc.getQuality();
+    else
+        return AccurateSine;
+}
+
+template < typename SampleType, template < typename T > class OscType >
+void OscEngine< SampleType, OscType >::setWavetable (typename WavetableData< SampleType >::Ptr table)
+{
+    if constexpr (std::is_same_v< OscType< SampleType >, Wavetable< SampleType > >)
+        osc.setTable (std::move (table));
+    else
+        juce::ignoreUnused (table);
 }
 
 template < typename SampleType, template < typename T > class OscType >
@@ -24,7 +78,7 @@ void OscEngine< SampleType, OscType >::renderBlock (const AudioBuffer&,
                                                     AudioBuffer& output,
                                                     MidiBuffer&, bool)
 {
-    osc.getSamples (output.getWritePointer (0), output.getNumSamples());
+    osc.renderBlock (output.getWritePointer (0), output.getNumSamples());
 }
 
 template < typename SampleType, template < typename T > class OscType >
@@ -44,6 +98,7 @@ BV_DECLARE_OSC_ENGINE (Saw)
 BV_DECLARE_OSC_ENGINE (Square)
 BV_DECLARE_OSC_ENGINE (Triangle)
 BV_DECLARE_OSC_ENGINE (SuperSaw)
+BV_DECLARE_OSC_ENGINE (Wavetable)
 
 #undef BV_DECLARE_OSC_ENGINE
 
@@ -3,8 +3,30 @@
 
 namespace bav::dsp::osc
 {
+/*
+    Type-erased interface to an OscEngine, so that ChoosableOscillator only has to hold the engine for its current OscType.
+    The oscillator-specific setters are no-ops for engines whose oscillator doesn't have that setting.
+*/
+template < typename SampleType >
+class OscEngineBase : public dsp::Engine< SampleType >
+{
+public:
+    virtual void  setFrequency (float freqHz) = 0;
+    virtual float getFrequency() const        = 0;
+
+    virtual void setDetuneAmount (int) { }
+    virtual int  getDetuneAmount() const { return 0; }
+
+    virtual void        setSineQuality (SineQuality) { }
+    virtual SineQuality getSineQuality() const { return AccurateSine; }
+
+    /* Safe to call from the message thread while the engine is rendering: the table is handed to the audio thread without locking. */
+    virtual void setWavetable (typename WavetableData< SampleType >::Ptr) { }
+};
+
+
 template < typename SampleType, template < typename T > class OscType >
-class OscEngine : public dsp::Engine< SampleType >
+class OscEngine : public OscEngineBase< SampleType >
 {
 public:
     using AudioBuffer = juce::AudioBuffer< SampleType >;
@@ -14,7 +36,16 @@ public:
 
     OscType< SampleType >* operator->();
 
-    void setFrequency (float freqHz);
+    void  setFrequency (float freqHz) final;
+    float getFrequency() const final;
+
+    void setDetuneAmount (int pitchSpreadCents) final;
+    int  getDetuneAmount() const final;
+
+    void        setSineQuality (SineQuality quality) final;
+    SineQuality getSineQuality() const final;
+
+    void setWavetable (typename WavetableData< SampleType >::Ptr table) final;
 
 private:
     void renderBlock (const AudioBuffer& input, AudioBuffer& output, MidiBuffer& midiMessages, bool isBypassed) final;
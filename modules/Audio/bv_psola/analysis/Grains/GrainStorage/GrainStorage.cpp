@@ -27,7 +27,7 @@ void AnalysisGrainStorage< SampleType >::storeNewFrame (const SampleType*
 template < typename SampleType >
 SampleType AnalysisGrainStorage< SampleType >::getSample (int grainStartIndexInCircularBuffer, int grainTick) const
 {
-    return buffer.getSample (buffer.clipValueToCapacity (grainStartIndexInCircularBuffer + grainTick));
+    return buffer.getSample (grainStartIndexInCircularBuffer + grainTick);
 }
 
 template < typename SampleType >
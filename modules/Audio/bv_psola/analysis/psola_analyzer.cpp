@@ -5,6 +5,10 @@ template < typename SampleType >
 void Analyzer< SampleType >::prepare (double sampleRate, int blocksize)
 {
     samplerate = sampleRate;
+
+    // the detector's period range is undefined until it has a Hz range
+    pitchDetector.initialize (blocksize);
+    pitchDetector.setHzRange (minDetectableHz, maxDetectableHz);
     pitchDetector.setSamplerate (sampleRate);
 
     grainExtractor.prepare (blocksize);
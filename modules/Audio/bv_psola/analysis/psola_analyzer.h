@@ -32,6 +32,9 @@ public:
     float getFrequency() const;
 
 private:
+    // frames passed to analyzeInput() must be at least two periods of minDetectableHz long
+    static constexpr int minDetectableHz = 60, maxDetectableHz = 2000;
+
     int          getNextUnpitchedPeriod();
     juce::Random rand;
 
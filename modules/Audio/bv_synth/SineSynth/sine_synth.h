@@ -14,7 +14,7 @@ public:
     void renderPlease (juce::AudioBuffer< SampleType >& output, float desiredFrequency, double currentSamplerate) final
     {
         osc.setFrequency (SampleType (desiredFrequency), SampleType (currentSamplerate));
-        osc.getSamples (output.getWritePointer (0), output.getNumSamples());
+        osc.renderBlock (output.getWritePointer (0), output.getNumSamples());
     }
 
     void released() final
@@ -133,6 +133,8 @@ void SynthBase< SampleType >::releaseResources()
 template < typename SampleType >
 void SynthBase< SampleType >::renderVoices (juce::MidiBuffer& midiMessages, juce::AudioBuffer< SampleType >& output)
 {
+    BV_REALTIME_SCOPE ("dsp::SynthBase::renderVoices");
+
     jassert (! voices.isEmpty());
     jassert (sampleRate > 0);
 
@@ -7,9 +7,14 @@
 #include "misc/misc.cpp"
 #include "misc/ValueSmoother.cpp"
 
+#include "realtime/RealtimeSafety.cpp"
+
 #include "files/FileUtilities.cpp"
 #include "binary_data/BinaryDataHelpers.cpp"
 
 #include "localization/localization.cpp"
 
 #include "events/events.cpp"
+
+// last, since it includes the platform headers
+#include "realtime/Semaphore.cpp"
@@ -43,6 +43,16 @@
 #    endif
 #endif
 
+//==============================================================================
+/** Config: BV_DETECT_REALTIME_VIOLATIONS
+ 
+    Set this to 1 to count the heap allocations, frees and mutex locks made inside real-time scopes, and record their call stacks.
+    This replaces the global allocator, so it is for debug and soak-test builds only. (See realtime/RealtimeSafety.h.)
+ */
+#ifndef BV_DETECT_REALTIME_VIOLATIONS
+#    define BV_DETECT_REALTIME_VIOLATIONS 0
+#endif
+
 #undef JUCE_USE_VDSP_FRAMEWORK
 #define JUCE_USE_VDSP_FRAMEWORK BV_USE_VDSP
 
@@ -67,6 +77,10 @@ using juce::ValueTree;
 #include "misc/ValueSmoother.h"
 #include "misc/TypeTraits.h"
 
+#include "realtime/RealtimeSafety.h"
+#include "realtime/Semaphore.h"
+#include "realtime/SnapshotHandoff.h"
+
 #include "events/Broadcaster.h"
 #include "events/Listener.h"
 #include "events/Timers.h"
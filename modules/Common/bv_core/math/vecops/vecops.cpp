@@ -271,6 +271,159 @@ void absVal (int* data, int size)
 }
 
 
+/* The bit layout of an IEEE float or double, for the log2 and exp2 approximations below. */
+template < typename Type >
+struct FloatBits
+{
+    using Int = std::conditional_t< std::is_same_v< Type, float >, std::int32_t, std::int64_t >;
+
+    static constexpr int mantissaBits = std::numeric_limits< Type >::digits - 1;
+    static constexpr Int exponentBias = std::numeric_limits< Type >::max_exponent - 1;
+};
+
+template < typename Type >
+void fastLog2 (Type* data, int dataSize)
+{
+#if BV_USE_VDSP
+    BV_VDSP_FUNC_SWITCH (vvlog2f, vvlog2,
+                         data, data, &dataSize)
+#else
+    using Bits = FloatBits< Type >;
+    using Int  = typename Bits::Int;
+
+    const auto sqrtHalf = static_cast< Type > (0.70710678118654752440L);
+
+    Int sqrtHalfBits;
+    memcpy (&sqrtHalfBits, &sqrtHalf, sizeof (Type));
+
+    for (int i = 0; i < dataSize; ++i)
+    {
+        Int bits;
+        memcpy (&bits, data + i, sizeof (Type));
+
+        // splits x into 2^exponent * m, with m in [sqrt(0.5), sqrt(2))
+        const auto exponent = (bits - sqrtHalfBits) >> Bits::mantissaBits;
+        bits -= exponent << Bits::mantissaBits;
+
+        Type m;
+        memcpy (&m, &bits, sizeof (Type));
+
+        // log2 (m) = 2 / ln (2) * atanh (s), with s = (m - 1) / (m + 1)
+        const auto s  = (m - Type (1)) / (m + Type (1));
+        const auto s2 = s * s;
+
+        const auto poly = Type (2.885390079803336) + s2 * (Type (0.9617988388020802) + s2 * (Type (0.5767151860235982) + s2 * Type (0.4317176973356515)));
+
+        data[i] = static_cast< Type > (exponent) + s * poly;
+    }
+#endif
+}
+template void fastLog2 (float*, int);
+template void fastLog2 (double*, int);
+
+template < typename Type >
+void fastExp2 (Type* data, int dataSize)
+{
+    using Bits = FloatBits< Type >;
+    using Int  = typename Bits::Int;
+
+    const auto maxExponent = static_cast< Type > (Bits::exponentBias);
+    const auto minExponent = Type (1) - maxExponent;
+
+#if BV_USE_VDSP
+    for (int i = 0; i < dataSize; ++i)
+        data[i] = std::min (maxExponent, std::max (minExponent, data[i]));
+
+    BV_VDSP_FUNC_SWITCH (vvexp2f, vvexp2,
+                         data, data, &dataSize)
+#else
+    for (int i = 0; i < dataSize; ++i)
+    {
+        const auto x = std::min (maxExponent, std::max (minExponent, data[i]));
+
+        // 2^x = 2^n * 2^f, with n the nearest integer to x and f in [-0.5, 0.5]
+        const auto n = std::floor (x + Type (0.5));
+        const auto f = x - n;
+
+        const auto poly = Type (1) + f * (Type (0.6931472067028321) + f * (Type (0.24022650922288827) + f * (Type (0.05550327226670944) + f * (Type (0.00961805667852609) + f * (Type (0.0013400428177419153) + f * Type (0.0001546144469646172))))));
+
+        const auto bits = (static_cast< Int > (n) + Bits::exponentBias) << Bits::mantissaBits;
+
+        Type scale;
+        memcpy (&scale, &bits, sizeof (Type));
+
+        data[i] = poly * scale;
+    }
+#endif
+}
+template void fastExp2 (float*, int);
+template void fastExp2 (double*, int);
+
+
+/* Geometric series are generated in interleaved lanes: each lane steps by ratio^lanes, so the terms of a group are independent of each other and can be computed with one vector multiply. */
+static constexpr int geometricLanes = 8;
+
+template < typename Type >
+static void initGeometricLanes (Type* terms, Type& stride, Type start, Type ratio)
+{
+    terms[0] = start;
+
+    for (int i = 1; i < geometricLanes; ++i)
+        terms[i] = terms[i - 1] * ratio;
+
+    stride = ratio;
+
+    for (int i = 1; i < geometricLanes; i *= 2)
+        stride *= stride;
+}
+
+template < typename Type >
+void fillGeometric (Type* vector, Type start, Type ratio, int count)
+{
+    Type terms[geometricLanes], stride;
+    initGeometricLanes (terms, stride, start, ratio);
+
+    int i = 0;
+
+    for (; i + geometricLanes <= count; i += geometricLanes)
+    {
+        for (int l = 0; l < geometricLanes; ++l)
+            vector[i + l] = terms[l];
+
+        for (int l = 0; l < geometricLanes; ++l)
+            terms[l] *= stride;
+    }
+
+    for (int l = 0; i < count; ++i, ++l)
+        vector[i] = terms[l];
+}
+template void fillGeometric (float*, float, float, int);
+template void fillGeometric (double*, double, double, int);
+
+template < typename Type >
+void multiplyGeometric (Type* vector, Type start, Type ratio, int count)
+{
+    Type terms[geometricLanes], stride;
+    initGeometricLanes (terms, stride, start, ratio);
+
+    int i = 0;
+
+    for (; i + geometricLanes <= count; i += geometricLanes)
+    {
+        for (int l = 0; l < geometricLanes; ++l)
+            vector[i + l] *= terms[l];
+
+        for (int l = 0; l < geometricLanes; ++l)
+            terms[l] *= stride;
+    }
+
+    for (int l = 0; i < count; ++i, ++l)
+        vector[i] *= terms[l];
+}
+template void multiplyGeometric (float*, float, float, int);
+template void multiplyGeometric (double*, double, double, int);
+
+
 template < typename Type >
 int findIndexOfMinElement (const Type* data, int dataSize)
 {
@@ -73,6 +73,26 @@ template < typename Type >
 void absVal (Type* data, int dataSize);
 
 
+/* replaces every element in the passed vector with an approximation of its base-2 logarithm, accurate to about 1e-9 before rounding to Type. The elements must not be negative. */
+template < typename Type >
+void fastLog2 (Type* data, int dataSize);
+
+
+/* replaces every element in the passed vector with an approximation of 2 raised to its power, accurate to about 1e-8 relative error. The exponents are clamped to the normal range of Type. */
+template < typename Type >
+void fastExp2 (Type* data, int dataSize);
+
+
+/* fills the vector with a geometric series: vector[i] = start * ratio^i */
+template < typename Type >
+void fillGeometric (Type* vector, Type start, Type ratio, int count);
+
+
+/* multiplies every element in the vector by the matching term of a geometric series: vector[i] *= start * ratio^i */
+template < typename Type >
+void multiplyGeometric (Type* vector, Type start, Type ratio, int count);
+
+
 /* returns the index in the vector of the minimum element */
 template < typename Type >
 int findIndexOfMinElement (const Type* data, int dataSize);
@@ -2,19 +2,92 @@
 namespace bav
 {
 template < typename SampleType >
-void ValueSmoother< SampleType >::set (SampleType newGain, bool snapImmediately)
+void ValueSmoother< SampleType >::reset (double samplerate, double rampLengthInSeconds)
 {
-    using SV = juce::SmoothedValue< SampleType, juce::ValueSmoothingTypes::Multiplicative >;
+    jassert (samplerate > 0 && rampLengthInSeconds >= 0);
+    reset (static_cast< int > (std::floor (rampLengthInSeconds * samplerate)));
+}
 
+template < typename SampleType >
+void ValueSmoother< SampleType >::reset (int numSteps)
+{
+    stepsToTarget = numSteps;
+    setCurrentAndTargetValue (target);
+}
+
+template < typename SampleType >
+void ValueSmoother< SampleType >::set (SampleType newGain, bool snapImmediately)
+{
     const auto newTarget = std::max (newGain, (SampleType) 0.0001);
 
     if (snapImmediately)
-        SV::setCurrentAndTargetValue (newTarget);
+        setCurrentAndTargetValue (newTarget);
     else
-        SV::setTargetValue (newTarget);
+        setTargetValue (newTarget);
+}
+
+template < typename SampleType >
+void ValueSmoother< SampleType >::setTargetValue (SampleType newValue)
+{
+    // a multiplicative ramp can't reach or cross zero
+    jassert (newValue > SampleType (0));
+
+    if (newValue == target) return;
+
+    if (stepsToTarget <= 0)
+    {
+        setCurrentAndTargetValue (newValue);
+        return;
+    }
+
+    target    = newValue;
+    countdown = stepsToTarget;
+    step      = std::exp ((std::log (target) - std::log (currentValue)) / static_cast< SampleType > (countdown));
+}
+
+template < typename SampleType >
+void ValueSmoother< SampleType >::setCurrentAndTargetValue (SampleType newValue)
+{
+    currentValue = target = newValue;
+    countdown             = 0;
+}
+
+template < typename SampleType >
+SampleType ValueSmoother< SampleType >::skip (int numSamples) noexcept
+{
+    if (numSamples >= countdown)
+    {
+        setCurrentAndTargetValue (target);
+        return target;
+    }
+
+    currentValue *= std::pow (step, static_cast< SampleType > (numSamples));
+    countdown -= numSamples;
+
+    return currentValue;
+}
+
+template < typename SampleType >
+void ValueSmoother< SampleType >::applyGain (SampleType* samples, int numSamples) noexcept
+{
+    if (countdown <= 0)
+    {
+        vecops::multiplyC (samples, target, numSamples);
+        return;
+    }
+
+    // the ramp's last value is set to the exact target, rather than the end of the series
+    const auto rampLength = std::min (numSamples, countdown - 1);
+
+    vecops::multiplyGeometric (samples, currentValue * step, step, rampLength);
+
+    if (numSamples > rampLength)
+        vecops::multiplyC (samples + rampLength, target, numSamples - rampLength);
+
+    skip (numSamples);
 }
 
-template struct ValueSmoother< float >;
-template struct ValueSmoother< double >;
+template class ValueSmoother< float >;
+template class ValueSmoother< double >;
 
 }  // namespace bav
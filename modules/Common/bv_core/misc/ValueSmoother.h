@@ -3,9 +3,19 @@
 
 namespace bav
 {
+/*
+    Smooths a positive value, such as a gain, multiplicatively, stepping by the same ratio every sample; this follows the same rules as a juce::SmoothedValue with the Multiplicative smoothing type.
+    applyGain() generates the whole ramp with one vector kernel instead of stepping through it, and skip() jumps ahead in closed form.
+*/
 template < typename SampleType >
-struct ValueSmoother : juce::SmoothedValue< SampleType, juce::ValueSmoothingTypes::Multiplicative >
+class ValueSmoother
 {
+public:
+    /* Sets the ramp length, and snaps the current value to the target. */
+    void reset (double samplerate, double rampLengthInSeconds);
+    void reset (int numSteps);
+
+    /* Targets below 0.0001 are clamped to it. */
     void set (SampleType newGain, bool snapImmediately = false);
 
     template < typename T >
@@ -13,6 +23,35 @@ struct ValueSmoother : juce::SmoothedValue< SampleType, juce::ValueSmoothingType
     {
         set (static_cast< SampleType > (newGain), snapImmediately);
     }
+
+    void setTargetValue (SampleType newValue);
+    void setCurrentAndTargetValue (SampleType newValue);
+
+    SampleType getNextValue() noexcept
+    {
+        if (countdown <= 0) return target;
+
+        if (--countdown > 0)
+            currentValue *= step;
+        else
+            currentValue = target;
+
+        return currentValue;
+    }
+
+    /* Advances the smoother by numSamples, and returns the new current value. */
+    SampleType skip (int numSamples) noexcept;
+
+    /* Multiplies the samples by the next numSamples values, advancing the smoother. */
+    void applyGain (SampleType* samples, int numSamples) noexcept;
+
+    SampleType getCurrentValue() const noexcept { return currentValue; }
+    SampleType getTargetValue() const noexcept { return target; }
+    bool       isSmoothing() const noexcept { return countdown > 0; }
+
+private:
+    SampleType currentValue {1}, target {1}, step {1};
+    int        countdown {0}, stepsToTarget {0};
 };
 
 }  // namespace bav
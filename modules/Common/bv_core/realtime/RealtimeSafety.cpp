@@ -0,0 +1,306 @@
+
+/*
+    With detection on, on Linux with glibc, malloc, calloc, realloc, free and the aligned allocators are replaced by versions that forward to glibc's own, and pthread_mutex_lock by one that forwards to the next definition found, so the C allocator, operator new, std::mutex and juce::CriticalSection are all covered.
+    Elsewhere only the global operator new and delete are replaced, so memory from malloc (such as juce::HeapBlock's) and mutex locks go unseen.
+    Replacing these symbols works for executables, such as soak tests and standalone apps; a plugin loaded by a host will usually get the host's definitions instead.
+    On Linux, link with -rdynamic to get function names in the recorded call stacks.
+*/
+#if BV_DETECT_REALTIME_VIOLATIONS && JUCE_LINUX && defined(__GLIBC__)
+#    define BV_REALTIME_HOOK_LIBC 1
+#    include <dlfcn.h>
+#    include <pthread.h>
+
+extern "C"
+{
+    void* __libc_malloc (size_t);
+    void* __libc_calloc (size_t, size_t);
+    void* __libc_realloc (void*, size_t);
+    void  __libc_free (void*);
+    void* __libc_memalign (size_t, size_t);
+}
+#else
+#    define BV_REALTIME_HOOK_LIBC 0
+#endif
+
+namespace bav::realtime
+{
+#if BV_DETECT_REALTIME_VIOLATIONS
+
+struct RealtimeThreadState
+{
+    const char* scope;
+    int         numSuspensions;  // above 0 while violations are allowed, or while the detector itself is running
+};
+
+// initial-exec TLS is reserved when a thread starts, so reading it can't call malloc and recurse into the hooks
+#    if JUCE_LINUX
+[[gnu::tls_model ("initial-exec")]]
+#    endif
+static thread_local RealtimeThreadState realtimeThreadState {nullptr, 0};
+
+static std::mutex                 realtimeReportLock;
+static std::vector< ScopeReport > realtimeReports;
+
+static void recordViolation (ViolationType type)
+{
+    auto& state = realtimeThreadState;
+
+    if (state.scope == nullptr || state.numSuspensions > 0) return;
+
+    // the detector's own allocations and locks aren't reported
+    const ScopedViolationsAllowed detecting;
+
+    const auto backtrace = juce::SystemStats::getStackBacktrace();
+
+    const std::lock_guard< std::mutex > lock {realtimeReportLock};
+
+    auto report = std::find_if (realtimeReports.begin(), realtimeReports.end(),
+                                [&state] (const ScopeReport& r)
+                                { return r.name == state.scope; });
+
+    if (report == realtimeReports.end())
+    {
+        realtimeReports.emplace_back();
+        realtimeReports.back().name = state.scope;
+        report                      = std::prev (realtimeReports.end());
+    }
+
+    switch (type)
+    {
+        case ViolationType::Allocation : ++report->numAllocations; break;
+        case ViolationType::Deallocation : ++report->numDeallocations; break;
+        case ViolationType::Lock : ++report->numLocks; break;
+    }
+
+    auto& stacks = report->callStacks;
+
+    auto stack = std::find_if (stacks.begin(), stacks.end(),
+                               [type, &backtrace] (const ScopeReport::CallStack& s)
+                               { return s.type == type && s.backtrace == backtrace; });
+
+    if (stack == stacks.end())
+        stacks.push_back ({type, backtrace, 1});
+    else
+        ++stack->count;
+}
+
+ScopedRealtimeSection::ScopedRealtimeSection (const char* scopeName) noexcept
+    : previousScope (realtimeThreadState.scope)
+{
+    realtimeThreadState.scope = scopeName;
+}
+
+ScopedRealtimeSection::~ScopedRealtimeSection() noexcept
+{
+    realtimeThreadState.scope = previousScope;
+}
+
+ScopedViolationsAllowed::ScopedViolationsAllowed() noexcept
+{
+    ++realtimeThreadState.numSuspensions;
+}
+
+ScopedViolationsAllowed::~ScopedViolationsAllowed() noexcept
+{
+    --realtimeThreadState.numSuspensions;
+}
+
+bool isDetectionEnabled() noexcept
+{
+    return true;
+}
+
+std::vector< ScopeReport > getReport()
+{
+    const ScopedViolationsAllowed reporting;
+
+    const std::lock_guard< std::mutex > lock {realtimeReportLock};
+
+    return realtimeReports;
+}
+
+void resetReport()
+{
+    const ScopedViolationsAllowed reporting;
+
+    const std::lock_guard< std::mutex > lock {realtimeReportLock};
+
+    realtimeReports.clear();
+}
+
+#else
+
+ScopedRealtimeSection::ScopedRealtimeSection (const char*) noexcept { }
+
+ScopedRealtimeSection::~ScopedRealtimeSection() noexcept { }
+
+ScopedViolationsAllowed::ScopedViolationsAllowed() noexcept { }
+
+ScopedViolationsAllowed::~ScopedViolationsAllowed() noexcept { }
+
+bool isDetectionEnabled() noexcept
+{
+    return false;
+}
+
+std::vector< ScopeReport > getReport()
+{
+    return {};
+}
+
+void resetReport()
+{
+}
+
+#endif
+
+String getReportAsString()
+{
+    String text;
+
+    for (const auto& report : getReport())
+    {
+        text << report.name << ": "
+             << String (report.numAllocations) << " allocations, "
+             << String (report.numDeallocations) << " frees, "
+             << String (report.numLocks) << " locks\n";
+
+        for (const auto& stack : report.callStacks)
+        {
+            const auto* typeName = stack.type == ViolationType::Allocation ? "allocation" : (stack.type == ViolationType::Deallocation ? "free" : "lock");
+
+            text << "  " << typeName << " x" << String (stack.count) << ":\n    "
+                 << stack.backtrace.trimEnd().replace ("\n", "\n    ") << "\n";
+        }
+    }
+
+    return text;
+}
+
+}  // namespace bav::realtime
+
+
+#if BV_REALTIME_HOOK_LIBC
+
+extern "C"
+{
+    void* malloc (size_t size) noexcept
+    {
+        bav::realtime::recordViolation (bav::realtime::ViolationType::Allocation);
+        return __libc_malloc (size);
+    }
+
+    void* calloc (size_t numElements, size_t elementSize) noexcept
+    {
+        bav::realtime::recordViolation (bav::realtime::ViolationType::Allocation);
+        return __libc_calloc (numElements, elementSize);
+    }
+
+    void* realloc (void* ptr, size_t size) noexcept
+    {
+        bav::realtime::recordViolation (bav::realtime::ViolationType::Allocation);
+        return __libc_realloc (ptr, size);
+    }
+
+    void free (void* ptr) noexcept
+    {
+        if (ptr != nullptr)
+            bav::realtime::recordViolation (bav::realtime::ViolationType::Deallocation);
+
+        __libc_free (ptr);
+    }
+
+    void* aligned_alloc (size_t alignment, size_t size) noexcept
+    {
+        bav::realtime::recordViolation (bav::realtime::ViolationType::Allocation);
+        return __libc_memalign (alignment, size);
+    }
+
+    int posix_memalign (void** result, size_t alignment, size_t size) noexcept
+    {
+        if (alignment % sizeof (void*) != 0 || (alignment & (alignment - 1)) != 0)
+            return EINVAL;
+
+        bav::realtime::recordViolation (bav::realtime::ViolationType::Allocation);
+
+        auto* ptr = __libc_memalign (alignment, size);
+
+        if (ptr == nullptr) return ENOMEM;
+
+        *result = ptr;
+        return 0;
+    }
+
+    int pthread_mutex_lock (pthread_mutex_t* mutex) noexcept
+    {
+        using LockFunction = int (*) (pthread_mutex_t*);
+
+        static std::atomic< LockFunction > realLock {nullptr};
+
+        auto lock = realLock.load (std::memory_order_relaxed);
+
+        if (lock == nullptr)
+        {
+            const bav::realtime::ScopedViolationsAllowed resolving;
+
+            lock = reinterpret_cast< LockFunction > (dlsym (RTLD_NEXT, "pthread_mutex_lock"));
+            realLock.store (lock, std::memory_order_relaxed);
+        }
+
+        bav::realtime::recordViolation (bav::realtime::ViolationType::Lock);
+        return lock (mutex);
+    }
+}
+
+#elif BV_DETECT_REALTIME_VIOLATIONS
+
+void* operator new (std::size_t size)
+{
+    bav::realtime::recordViolation (bav::realtime::ViolationType::Allocation);
+
+    if (auto* ptr = std::malloc (size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size)
+{
+    return operator new (size);
+}
+
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept
+{
+    bav::realtime::recordViolation (bav::realtime::ViolationType::Allocation);
+    return std::malloc (size == 0 ? 1 : size);
+}
+
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept
+{
+    return operator new (size, std::nothrow);
+}
+
+void operator delete (void* ptr) noexcept
+{
+    if (ptr != nullptr)
+        bav::realtime::recordViolation (bav::realtime::ViolationType::Deallocation);
+
+    std::free (ptr);
+}
+
+void operator delete[] (void* ptr) noexcept
+{
+    operator delete (ptr);
+}
+
+void operator delete (void* ptr, std::size_t) noexcept
+{
+    operator delete (ptr);
+}
+
+void operator delete[] (void* ptr, std::size_t) noexcept
+{
+    operator delete (ptr);
+}
+
+#endif
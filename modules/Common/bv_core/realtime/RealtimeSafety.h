@@ -0,0 +1,81 @@
+#pragma once
+
+namespace bav::realtime
+{
+/*
+    Marks the calling thread as running real-time code for as long as this object exists. Scopes can nest; anything detected is attributed to the innermost one.
+    When BV_DETECT_REALTIME_VIOLATIONS is 1, heap allocations, frees and mutex locks made inside a scope are counted, and the call stack of each is recorded. Otherwise this does nothing; use the BV_REALTIME_SCOPE macro, which then compiles away entirely.
+    The name must be a string literal, or otherwise outlive the scope.
+*/
+class ScopedRealtimeSection
+{
+public:
+    explicit ScopedRealtimeSection (const char* scopeName) noexcept;
+    ~ScopedRealtimeSection() noexcept;
+
+private:
+#if BV_DETECT_REALTIME_VIOLATIONS
+    const char* previousScope;
+#endif
+
+    JUCE_DECLARE_NON_COPYABLE (ScopedRealtimeSection)
+};
+
+
+/* Pauses detection on the calling thread, for code inside a real-time scope that is knowingly unsafe, such as a resize that only happens when the blocksize changes. */
+class ScopedViolationsAllowed
+{
+public:
+    ScopedViolationsAllowed() noexcept;
+    ~ScopedViolationsAllowed() noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE (ScopedViolationsAllowed)
+};
+
+
+enum class ViolationType
+{
+    Allocation,
+    Deallocation,
+    Lock
+};
+
+struct ScopeReport
+{
+    struct CallStack
+    {
+        ViolationType type;
+        String        backtrace;
+        int64_t       count {0};
+    };
+
+    String name;
+
+    int64_t numAllocations {0};
+    int64_t numDeallocations {0};
+    int64_t numLocks {0};
+
+    std::vector< CallStack > callStacks;  // each distinct call stack that was detected, with how many times it was seen
+};
+
+/* True if this build was made with BV_DETECT_REALTIME_VIOLATIONS enabled. */
+bool isDetectionEnabled() noexcept;
+
+/* Everything detected since the last call to resetReport(), with one entry for each scope that had any violations. Can be called from any thread. */
+std::vector< ScopeReport > getReport();
+
+/* The report as readable text, e.g. for a soak test to print or fail on. Empty if nothing has been detected. */
+String getReportAsString();
+
+void resetReport();
+
+}  // namespace bav::realtime
+
+
+#if BV_DETECT_REALTIME_VIOLATIONS
+#    define BV_REALTIME_SCOPE(scopeName) const ::bav::realtime::ScopedRealtimeSection JUCE_JOIN_MACRO (bvRealtimeScope_, __LINE__) (scopeName)
+#    define BV_ALLOW_REALTIME_VIOLATIONS const ::bav::realtime::ScopedViolationsAllowed JUCE_JOIN_MACRO (bvViolationsAllowed_, __LINE__)
+#else
+#    define BV_REALTIME_SCOPE(scopeName)
+#    define BV_ALLOW_REALTIME_VIOLATIONS
+#endif
@@ -0,0 +1,176 @@
+
+#if JUCE_MAC || JUCE_IOS
+#    include <dispatch/dispatch.h>
+#elif JUCE_WINDOWS
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    include <windows.h>
+#else
+#    include <semaphore.h>
+#    include <cerrno>
+#    include <ctime>
+#endif
+
+namespace bav::realtime
+{
+/* The OS semaphore that parked threads sleep on. Posting to it is lock-free on every platform. */
+#if JUCE_MAC || JUCE_IOS
+
+struct Semaphore::Native
+{
+    Native() : semaphore (dispatch_semaphore_create (0)) { }
+    ~Native() { dispatch_release (semaphore); }
+
+    void post (int numToPost) noexcept
+    {
+        while (numToPost-- > 0)
+            dispatch_semaphore_signal (semaphore);
+    }
+
+    bool wait (int timeoutMs) noexcept
+    {
+        const auto timeout = timeoutMs < 0 ? DISPATCH_TIME_FOREVER
+                                           : dispatch_time (DISPATCH_TIME_NOW, static_cast< int64_t > (timeoutMs) * 1000000);
+
+        return dispatch_semaphore_wait (semaphore, timeout) == 0;
+    }
+
+    bool tryWait() noexcept { return dispatch_semaphore_wait (semaphore, DISPATCH_TIME_NOW) == 0; }
+
+    dispatch_semaphore_t semaphore;
+};
+
+#elif JUCE_WINDOWS
+
+struct Semaphore::Native
+{
+    Native() : semaphore (CreateSemaphoreW (nullptr, 0, MAXLONG, nullptr)) { }
+    ~Native() { CloseHandle (semaphore); }
+
+    void post (int numToPost) noexcept { ReleaseSemaphore (semaphore, numToPost, nullptr); }
+
+    bool wait (int timeoutMs) noexcept
+    {
+        return WaitForSingleObject (semaphore, timeoutMs < 0 ? INFINITE : static_cast< DWORD > (timeoutMs)) == WAIT_OBJECT_0;
+    }
+
+    bool tryWait() noexcept { return WaitForSingleObject (semaphore, 0) == WAIT_OBJECT_0; }
+
+    HANDLE semaphore;
+};
+
+#else
+
+struct Semaphore::Native
+{
+    Native() { sem_init (&semaphore, 0, 0); }
+    ~Native() { sem_destroy (&semaphore); }
+
+    void post (int numToPost) noexcept
+    {
+        while (numToPost-- > 0)
+            sem_post (&semaphore);
+    }
+
+    bool wait (int timeoutMs) noexcept
+    {
+        if (timeoutMs < 0)
+        {
+            while (sem_wait (&semaphore) != 0)
+                if (errno != EINTR) return false;
+
+            return true;
+        }
+
+        timespec deadline;
+        clock_gettime (CLOCK_REALTIME, &deadline);
+
+        deadline.tv_sec += timeoutMs / 1000;
+        deadline.tv_nsec += static_cast< long > (timeoutMs % 1000) * 1000000;
+
+        if (deadline.tv_nsec >= 1000000000)
+        {
+            deadline.tv_sec += 1;
+            deadline.tv_nsec -= 1000000000;
+        }
+
+        while (sem_timedwait (&semaphore, &deadline) != 0)
+            if (errno != EINTR) return false;
+
+        return true;
+    }
+
+    bool tryWait() noexcept
+    {
+        while (sem_trywait (&semaphore) != 0)
+            if (errno != EINTR) return false;
+
+        return true;
+    }
+
+    sem_t semaphore;
+};
+
+#endif
+
+/*--------------------------------------------------------------------------------------------------------------*/
+
+Semaphore::Semaphore()
+    : native (std::make_unique< Native >())
+{
+}
+
+Semaphore::~Semaphore() = default;
+
+void Semaphore::signal (int numToSignal) noexcept
+{
+    const auto oldCount = count.fetch_add (numToSignal, std::memory_order_release);
+
+    // only the threads that are parked, or about to park, need the OS semaphore
+    const auto numToWake = std::min (-oldCount, numToSignal);
+
+    if (numToWake > 0)
+        native->post (numToWake);
+}
+
+bool Semaphore::tryWait() noexcept
+{
+    auto oldCount = count.load (std::memory_order_relaxed);
+
+    while (oldCount > 0)
+        if (count.compare_exchange_weak (oldCount, oldCount - 1, std::memory_order_acquire, std::memory_order_relaxed))
+            return true;
+
+    return false;
+}
+
+bool Semaphore::wait (int timeoutMs) noexcept
+{
+    for (int spin = 0; spin < numSpinsBeforeParking; ++spin)
+        if (tryWait())
+            return true;
+
+    if (count.fetch_sub (1, std::memory_order_acquire) > 0)
+        return true;
+
+    if (native->wait (timeoutMs))
+        return true;
+
+    // Timed out, so this thread's decrement must be taken back. If a signal() has already counted it and is posting to the OS semaphore, that post is consumed instead.
+    while (true)
+    {
+        auto oldCount = count.load (std::memory_order_relaxed);
+
+        if (oldCount >= 0 && native->tryWait())
+            return true;
+
+        if (oldCount < 0 && count.compare_exchange_strong (oldCount, oldCount + 1, std::memory_order_relaxed))
+            return false;
+    }
+}
+
+}  // namespace bav::realtime
@@ -0,0 +1,36 @@
+#pragma once
+
+namespace bav::realtime
+{
+/*
+    A counting semaphore for waking worker threads from the audio thread.
+    signal() never locks: it is an atomic increment, plus a post to the OS semaphore only when a thread is actually parked on it.
+    wait() spins for a while before parking, so a worker that is signalled again soon after running out of work picks it up without a trip through the kernel.
+*/
+class Semaphore
+{
+public:
+    Semaphore();
+    ~Semaphore();
+
+    /* Real-time safe. */
+    void signal (int count = 1) noexcept;
+
+    /* Returns false if the timeout, in milliseconds, runs out first; a timeout of -1 waits forever. */
+    bool wait (int timeoutMs = -1) noexcept;
+
+    /* Takes a count if one is available, without waiting. */
+    bool tryWait() noexcept;
+
+private:
+    static constexpr int numSpinsBeforeParking = 10000;
+
+    struct Native;
+
+    std::atomic< int >        count {0};  // below zero, minus the number of parked threads
+    std::unique_ptr< Native > native;
+
+    JUCE_DECLARE_NON_COPYABLE (Semaphore)
+};
+
+}  // namespace bav::realtime
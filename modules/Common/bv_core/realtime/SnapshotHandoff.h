@@ -0,0 +1,77 @@
+#pragma once
+
+namespace bav::realtime
+{
+/*
+    Hands immutable snapshots of some state from the message thread to the audio thread, without the audio thread ever locking or deleting anything.
+    The message thread publishes a new snapshot with an atomic pointer swap. Replaced snapshots are kept until the audio thread is done with them, then deleted on the message thread by a later publish().
+    The audio thread brackets each use of a snapshot with acquire() and release(). Only one audio thread may do so.
+*/
+template < typename SnapshotType >
+class SnapshotHandoff
+{
+public:
+    SnapshotHandoff() = default;
+
+    ~SnapshotHandoff() { delete current.exchange (nullptr); }
+
+    /*
+        Called on the message thread. Makes the new snapshot current, and reclaims any replaced snapshots the audio thread is done with.
+        If a snapshot was replaced, onReplaced is called with it before anything is reclaimed; anything the audio thread could still be using, such as objects removed from the state, can be moved into it to be deleted along with it.
+    */
+    template < typename Callback >
+    void publish (std::unique_ptr< SnapshotType > newSnapshot, Callback&& onReplaced)
+    {
+        std::unique_ptr< SnapshotType > old {current.exchange (newSnapshot.release())};
+
+        if (old != nullptr)
+        {
+            onReplaced (*old);
+            retired.push_back (std::move (old));
+        }
+
+        reclaim();
+    }
+
+    /* Called on the audio thread. The returned snapshot, which may be nullptr, won't be deleted until release() is called. */
+    SnapshotType* acquire() noexcept
+    {
+        // announce the snapshot before using it, then check it wasn't retired in the meantime; a snapshot retired before it was announced is never dereferenced
+        auto* snapshot = current.load();
+
+        for (;;)
+        {
+            inUse.store (snapshot);
+
+            auto* latest = current.load();
+
+            if (latest == snapshot) return snapshot;
+
+            snapshot = latest;
+        }
+    }
+
+    void release() noexcept { inUse.store (nullptr); }
+
+private:
+    void reclaim()
+    {
+        // anything moved into a retired snapshot may also be referenced by every older one, so only the snapshots retired before the one in use can go
+        const auto* snapshotInUse = inUse.load();
+
+        const auto firstToKeep = std::find_if (retired.begin(), retired.end(),
+                                               [snapshotInUse] (const std::unique_ptr< SnapshotType >& s)
+                                               { return s.get() == snapshotInUse; });
+
+        retired.erase (retired.begin(), firstToKeep);
+    }
+
+    std::atomic< SnapshotType* > current {nullptr};
+    std::atomic< SnapshotType* > inUse {nullptr};
+
+    std::vector< std::unique_ptr< SnapshotType > > retired;
+
+    JUCE_DECLARE_NON_COPYABLE (SnapshotHandoff)
+};
+
+}  // namespace bav::realtime
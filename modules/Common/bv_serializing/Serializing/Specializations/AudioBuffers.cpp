@@ -18,7 +18,7 @@ juce::MemoryBlock toMemory (const juce::AudioBuffer< double >& buffer)
     const auto numSamples  = buffer.getNumSamples();
     const auto numChannels = buffer.getNumChannels();
 
-    juce::AudioBuffer< float > temp {numSamples, numChannels};
+    juce::AudioBuffer< float > temp {numChannels, numSamples};
 
     for (int chan = 0; chan < numChannels; ++chan)
         vecops::convert (temp.getWritePointer (chan), buffer.getReadPointer (chan), numSamples);
@@ -70,15 +70,15 @@ void stringToBuffer (const String& string, juce::AudioBuffer< float >& buffer)
 
 void stringToBuffer (const String& string, juce::AudioBuffer< double >& buffer)
 {
-    const auto numSamples  = buffer.getNumSamples();
-    const auto numChannels = buffer.getNumChannels();
+    juce::AudioBuffer< float > temp;
 
-    juce::AudioBuffer< float > temp {numSamples, numChannels};
+    stringToBuffer (string, temp);
 
-    for (int chan = 0; chan < numChannels; ++chan)
-        vecops::convert (temp.getWritePointer (chan), buffer.getReadPointer (chan), numSamples);
+    // the decoded audio decides the size
+    const auto numSamples  = temp.getNumSamples();
+    const auto numChannels = temp.getNumChannels();
 
-    stringToBuffer (string, temp);
+    buffer.setSize (numChannels, numSamples);
 
     for (int chan = 0; chan < numChannels; ++chan)
         vecops::convert (buffer.getWritePointer (chan), temp.getReadPointer (chan), numSamples);
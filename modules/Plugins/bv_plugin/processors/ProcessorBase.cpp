@@ -70,6 +70,8 @@ void ProcessorBase::setStateInformation (const void* data, int size)
 
 void ProcessorBase::processBlock (juce::AudioBuffer< float >& audio, MidiBuffer& midi)
 {
+    BV_REALTIME_SCOPE ("plugin::ProcessorBase::processBlock");
+
     juce::ScopedNoDenormals nodenorms;
 
     floatEngine.process (audio, midi);
@@ -77,6 +79,8 @@ void ProcessorBase::processBlock (juce::AudioBuffer< float >& audio, MidiBuffer&
 
 void ProcessorBase::processBlock (juce::AudioBuffer< double >& audio, MidiBuffer& midi)
 {
+    BV_REALTIME_SCOPE ("plugin::ProcessorBase::processBlock");
+
     juce::ScopedNoDenormals nodenorms;
 
     doubleEngine.process (audio, midi);
@@ -84,6 +88,8 @@ void ProcessorBase::processBlock (juce::AudioBuffer< double >& audio, MidiBuffer
 
 void ProcessorBase::processBlockBypassed (juce::AudioBuffer< float >& audio, MidiBuffer& midi)
 {
+    BV_REALTIME_SCOPE ("plugin::ProcessorBase::processBlock");
+
     juce::ScopedNoDenormals nodenorms;
 
     state.mainBypass->set (true);
@@ -92,6 +98,8 @@ void ProcessorBase::processBlockBypassed (juce::AudioBuffer< float >& audio, Mid
 
 void ProcessorBase::processBlockBypassed (juce::AudioBuffer< double >& audio, MidiBuffer& midi)
 {
+    BV_REALTIME_SCOPE ("plugin::ProcessorBase::processBlock");
+
     juce::ScopedNoDenormals nodenorms;
 
     state.mainBypass->set (true);